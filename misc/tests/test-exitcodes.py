@@ -67,6 +67,10 @@ SEARCH_TESTS = [
     ("strips", [], "astar(landmark_cost_partitioning(lm_hm()))",
         defaultdict(lambda: returncodes.SUCCESS)),
     ("strips", [], MERGE_AND_SHRINK, defaultdict(lambda: returncodes.SUCCESS)),
+    # Leaves several factors, whose variables are ordered by partition in the BDDs.
+    ("strips", [], "astar(blind(), pruning=dominance("
+        "fts_factory=merge_and_shrink(max_total_states=100), database=bdd_map()))",
+        defaultdict(lambda: returncodes.SUCCESS)),
     ("axioms", [], "astar(add())", defaultdict(lambda: returncodes.SUCCESS)),
     ("axioms", [], "astar(hm())",
         defaultdict(lambda: returncodes.SEARCH_UNSOLVED_INCOMPLETE)),
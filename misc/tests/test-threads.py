@@ -0,0 +1,65 @@
+import os
+import re
+import subprocess
+import sys
+
+import pytest
+
+DIR = os.path.dirname(os.path.abspath(__file__))
+REPO = os.path.dirname(os.path.dirname(DIR))
+BENCHMARKS_DIR = os.path.join(REPO, "misc", "tests", "benchmarks")
+FAST_DOWNWARD = os.path.join(REPO, "fast-downward.py")
+SAS_FILE = os.path.join(REPO, "test-threads.sas")
+TASK = os.path.join(BENCHMARKS_DIR, "miconic/s1-0.pddl")
+
+# Configurations whose search must not depend on the number of threads.
+CONFIGS = {
+    "delete_relaxation_if": (
+        "astar(operatorcounting([delete_relaxation_if_constraints()], "
+        "threads={threads}, lpsolver={lp_solver}))"),
+    "delete_relaxation_rr": (
+        "astar(operatorcounting([delete_relaxation_rr_constraints()], "
+        "threads={threads}, lpsolver={lp_solver}))"),
+}
+
+# Lines of the output that depend on the heuristic values of the evaluated states.
+RESULT_PATTERNS = [
+    r"Initial heuristic value for .*: .*",
+    r"f = \d+, \d+ evaluated, \d+ expanded",
+    r"Expanded \d+ state\(s\)\.",
+    r"Evaluated \d+ state\(s\)\.",
+    r"Plan cost: \d+",
+]
+
+
+def translate(task):
+    subprocess.check_call([
+        sys.executable, FAST_DOWNWARD, "--sas-file", SAS_FILE, "--translate", task], cwd=REPO)
+
+
+def run_search(search):
+    output = subprocess.check_output(
+        [sys.executable, FAST_DOWNWARD, SAS_FILE, "--search", search],
+        cwd=REPO, universal_newlines=True)
+    return [match.group(0) for pattern in RESULT_PATTERNS
+            for match in re.finditer(pattern, output)]
+
+
+def setup_module(module):
+    translate(TASK)
+
+
+@pytest.mark.parametrize("config", sorted(CONFIGS))
+@pytest.mark.parametrize("lp_solver", ["cplex", "soplex"])
+def test_same_heuristic_values_with_threads(config, lp_solver):
+    sequential = run_search(CONFIGS[config].format(threads=1, lp_solver=lp_solver))
+    parallel = run_search(CONFIGS[config].format(threads=4, lp_solver=lp_solver))
+    assert sequential
+    assert sequential == parallel
+
+
+def teardown_module(module):
+    os.remove(SAS_FILE)
+    plan_file = os.path.join(REPO, "sas_plan")
+    if os.path.exists(plan_file):
+        os.remove(plan_file)
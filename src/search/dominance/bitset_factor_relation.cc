@@ -0,0 +1,198 @@
+#include "bitset_factor_relation.h"
+
+#include "label_relation.h"
+#include "../factored_transition_system/fts_task.h"
+#include "../factored_transition_system/labelled_transition_system.h"
+#include "../plugins/plugin.h"
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+
+using namespace std;
+using fts::LabelGroup;
+using fts::LabelledTransitionSystem;
+using fts::TSTransition;
+
+namespace dominance {
+    BitsetFactorRelation::BitsetFactorRelation(const LabelledTransitionSystem& lts) : FactorDominanceRelation(lts.size()),
+        words_per_row((lts.size() + BITS_PER_WORD - 1) / BITS_PER_WORD),
+        simulated_by(static_cast<size_t>(lts.size()) * words_per_row, 0) {
+        int num_states = lts.size();
+        const std::vector<bool> &goal_states = lts.get_goal_states();
+        for (int s = 0; s < num_states; ++s) {
+            Word *bits = row(s);
+            for (int t = 0; t < num_states; ++t) {
+                // t can only simulate s if goal(s) => goal(t)
+                if (!goal_states[s] || goal_states[t]) {
+                    set_bit(bits, t);
+                }
+            }
+        }
+    }
+
+    bool BitsetFactorRelation::apply_to_simulations_until(std::function<bool(int s, int t)>&& f) const {
+        for (int t = 0; t < get_num_states(); ++t) {
+            const Word *bits = row(t);
+            for (int w = 0; w < words_per_row; ++w) {
+                for (Word word = bits[w]; word; word &= word - 1) {
+                    int s = w * BITS_PER_WORD + countr_zero(word);
+                    if (f(s, t)) {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    bool BitsetFactorRelation::remove_simulations_if(std::function<bool(int s, int t)>&& f) {
+        bool any = false;
+        for (int t = 0; t < get_num_states(); ++t) {
+            Word *bits = row(t);
+            for (int w = 0; w < words_per_row; ++w) {
+                for (Word word = bits[w]; word; word &= word - 1) {
+                    int s = w * BITS_PER_WORD + countr_zero(word);
+                    if (s != t && f(s, t)) {
+                        reset_bit(bits, s);
+                        any = true;
+                    }
+                }
+            }
+        }
+        return any;
+    }
+
+    namespace {
+        // How a transition with a given label can be answered in the factor
+        struct LabelResponses {
+            // The label is dominated by noop or by an irrelevant label, so t can answer by staying in t
+            bool noop;
+            // Relevant label groups containing some label that dominates the label
+            std::vector<int> label_groups;
+
+            bool operator<(const LabelResponses &other) const {
+                return noop < other.noop || (noop == other.noop && label_groups < other.label_groups);
+            }
+
+            bool operator==(const LabelResponses &other) const {
+                return noop == other.noop && label_groups == other.label_groups;
+            }
+        };
+    }
+
+    bool BitsetFactorRelation::update(int factor, const fts::FTSTask& fts_task, const LabelRelation& label_dominance) {
+        const LabelledTransitionSystem& lts = fts_task.get_factor(factor);
+        const std::vector<LabelGroup>& relevant_label_groups = lts.get_relevant_label_groups();
+
+        /*
+          Check if t simulates s: for each transition s--l-->s'
+            a) t >= s' and l is dominated by noop or by an irrelevant label (a self-loop in t), or
+            b) there exists t--l'-->t' with t' >= s' and l' dominates l.
+          Transitions of irrelevant label groups are self-loops in every state, so (as both the label relation and
+          the factor relation are reflexive) they are always answered by the same transition of t and need not be
+          checked. The label relation does not change during the update, so the possible responses of each label
+          are computed once, and labels of the same group with the same responses are checked together.
+        */
+        std::vector<int> irrelevant_labels;
+        std::ranges::copy(lts.get_irrelevant_labels(), std::back_inserter(irrelevant_labels));
+
+        std::vector<std::vector<LabelResponses>> responses_by_group(relevant_label_groups.size());
+        for (size_t i = 0; i < relevant_label_groups.size(); ++i) {
+            for (int l : lts.get_labels(relevant_label_groups[i])) {
+                LabelResponses responses;
+                responses.noop = label_dominance.noop_dominates_label_in_all_other(factor, fts_task, l) ||
+                    std::ranges::any_of(irrelevant_labels, [&](int l2) {
+                        return label_dominance.label_dominates_label_in_all_other(factor, fts_task, l2, l);
+                    });
+                for (LabelGroup lg : relevant_label_groups) {
+                    if (std::ranges::any_of(lts.get_labels(lg), [&](int l2) {
+                            return label_dominance.label_dominates_label_in_all_other(factor, fts_task, l2, l);
+                        })) {
+                        responses.label_groups.push_back(lg.group);
+                    }
+                }
+                responses_by_group[i].push_back(std::move(responses));
+            }
+            std::vector<LabelResponses>& group_responses = responses_by_group[i];
+            std::sort(group_responses.begin(), group_responses.end());
+            group_responses.erase(std::unique(group_responses.begin(), group_responses.end()), group_responses.end());
+        }
+
+        // Transitions of each relevant label group sorted by target, so that we compute the responses once per target
+        std::vector<std::vector<TSTransition>> transitions_by_target(relevant_label_groups.size());
+        for (size_t i = 0; i < relevant_label_groups.size(); ++i) {
+            transitions_by_target[i] = lts.get_transitions_label_group(relevant_label_groups[i]);
+            std::ranges::sort(transitions_by_target[i], [](const TSTransition& a, const TSTransition& b) {
+                return a.target < b.target || (a.target == b.target && a.src < b.src);
+            });
+        }
+
+        std::vector<Word> can_respond(words_per_row);
+        bool any_changes = false;
+        bool changes = true;
+        while (changes) {
+            changes = false;
+            for (size_t i = 0; i < relevant_label_groups.size(); ++i) {
+                const std::vector<TSTransition>& transitions = transitions_by_target[i];
+                for (const LabelResponses& responses : responses_by_group[i]) {
+                    for (size_t begin = 0, end = 0; begin < transitions.size(); begin = end) {
+                        int target = transitions[begin].target;
+                        end = begin;
+                        while (end < transitions.size() && transitions[end].target == target) {
+                            ++end;
+                        }
+
+                        // States t that can answer a transition to target: t >= target, or t--l'-->t' with t' >= target
+                        const Word *target_simulated_by = row(target);
+                        if (responses.noop) {
+                            std::copy_n(target_simulated_by, words_per_row, can_respond.begin());
+                        } else {
+                            std::ranges::fill(can_respond, 0);
+                        }
+                        for (int lg : responses.label_groups) {
+                            for (const TSTransition& tr : lts.get_transitions_label_group(LabelGroup(lg))) {
+                                if (test_bit(target_simulated_by, tr.target)) {
+                                    set_bit(can_respond.data(), tr.src);
+                                }
+                            }
+                        }
+
+                        for (size_t j = begin; j < end; ++j) {
+                            int s = transitions[j].src;
+                            Word *bits = row(s);
+                            for (int w = 0; w < words_per_row; ++w) {
+                                Word refined = bits[w] & can_respond[w];
+                                if (w == s / BITS_PER_WORD) {
+                                    // Every state simulates itself
+                                    refined |= Word(1) << (s % BITS_PER_WORD);
+                                }
+                                if (refined != bits[w]) {
+                                    bits[w] = refined;
+                                    changes = true;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            any_changes |= changes;
+        }
+        return any_changes;
+    }
+
+    using BitsetFactorRelationFactory = FactorDominanceRelationFactoryImpl<BitsetFactorRelation>;
+    class BitsetFactorRelationFactoryFeature final : public plugins::TypedFeature<FactorDominanceRelationFactory, BitsetFactorRelationFactory> {
+    public:
+        BitsetFactorRelationFactoryFeature() : TypedFeature("bitset_fdr") {
+            document_title("Bitset Factor Dominance Relation");
+            document_synopsis("Stores the simulation relation between states as rows of 64-bit words, and refines it "
+                              "with word-parallel operations over the rows instead of checking each pair of states");
+        }
+
+        std::shared_ptr<BitsetFactorRelationFactory> create_component(const plugins::Options &/*opts*/) const override {
+            return plugins::make_shared_from_arg_tuples<BitsetFactorRelationFactory>();
+        }
+    };
+    static plugins::FeaturePlugin<BitsetFactorRelationFactoryFeature> _bitset_plugin;
+}
@@ -0,0 +1,67 @@
+#ifndef DOMINANCE_BITSET_FACTOR_RELATION_H
+#define DOMINANCE_BITSET_FACTOR_RELATION_H
+
+#include <cstdint>
+#include <vector>
+
+#include "factor_dominance_relation.h"
+
+namespace dominance {
+    /**
+     * BitsetFactorRelation stores the simulation relation of a single LTS as one bit row per state, packed into
+     * 64-bit words. Row s contains the states t that simulate s, so that the refinement can compute, for each
+     * transition s--l-->s', the set of states that can respond to it with whole-word operations on the rows.
+     *
+     * The relation must be a superset of the identity relation.
+     */
+    class BitsetFactorRelation final : public FactorDominanceRelation {
+        using Word = uint64_t;
+        static constexpr int BITS_PER_WORD = 64;
+
+        int words_per_row;
+        // All rows in one contiguous array. Bit t of row s is set if t simulates s.
+        std::vector<Word> simulated_by;
+
+        Word *row(int s) {
+            return simulated_by.data() + static_cast<size_t>(s) * words_per_row;
+        }
+
+        [[nodiscard]] const Word *row(int s) const {
+            return simulated_by.data() + static_cast<size_t>(s) * words_per_row;
+        }
+
+        static bool test_bit(const Word *bits, int i) {
+            return (bits[i / BITS_PER_WORD] >> (i % BITS_PER_WORD)) & 1;
+        }
+
+        static void set_bit(Word *bits, int i) {
+            bits[i / BITS_PER_WORD] |= Word(1) << (i % BITS_PER_WORD);
+        }
+
+        static void reset_bit(Word *bits, int i) {
+            bits[i / BITS_PER_WORD] &= ~(Word(1) << (i % BITS_PER_WORD));
+        }
+
+    public:
+        explicit BitsetFactorRelation(const fts::LabelledTransitionSystem& lts);
+
+        [[nodiscard]] bool simulates(int s, int t) const override {
+            return test_bit(row(t), s);
+        }
+
+        [[nodiscard]] bool similar(int s, int t) const override {
+            return simulates(s, t) && simulates(t, s);
+        }
+
+        void remove(int s, int t) override {
+            reset_bit(row(t), s);
+        }
+
+        bool apply_to_simulations_until(std::function<bool(int s, int t)> &&f) const override;
+        bool remove_simulations_if(std::function<bool(int s, int t)> &&f) override;
+
+        bool update(int factor, const fts::FTSTask& fts_task, const LabelRelation& label_dominance) override;
+    };
+}
+
+#endif
@@ -20,7 +20,7 @@ namespace dominance {
     public:
         explicit DenseFactorRelation(const fts::LabelledTransitionSystem& lts);
 
-        void remove(int s, int t) {
+        void remove(int s, int t) override {
             relation[s][t] = false;
         }
 
@@ -4,7 +4,9 @@
 #include "factor_dominance_relation.h"
 #include "../plugins/plugin.h"
 
+#include <algorithm>
 #include <cassert>
+#include <set>
 
 namespace dominance {
     bool DenseLabelRelation::simulates(int l1, int l2, int factor) const {
@@ -49,82 +51,199 @@ namespace dominance {
     }
 
     bool DenseLabelRelation::update_factor(int factor, const fts::FTSTask& fts_task, const FactorDominanceRelation& sim) {
-        bool changes = false;
         const fts::LabelledTransitionSystem& lts = fts_task.get_factor(factor);
+        return apply_factor_update(factor, lts, compute_factor_update(factor, lts, sim));
+    }
+
+    std::function<bool()> DenseLabelRelation::collect_factor_update(int factor, const fts::FTSTask& fts_task, const FactorDominanceRelation& sim) {
+        const fts::LabelledTransitionSystem& lts = fts_task.get_factor(factor);
+        return [this, factor, &lts, update = compute_factor_update(factor, lts, sim)]() {
+            return apply_factor_update(factor, lts, update);
+        };
+    }
+
+    DenseLabelRelation::FactorUpdate DenseLabelRelation::compute_factor_update(int factor, const fts::LabelledTransitionSystem& lts, const FactorDominanceRelation& sim) const {
+        FactorUpdate update;
         for (fts::LabelGroup lg_2: lts.get_relevant_label_groups()) {
-            for (int l2 : lts.get_labels(lg_2)) {
-                for (fts::LabelGroup lg_1: lts.get_relevant_label_groups()) {
+            for (fts::LabelGroup lg_1: lts.get_relevant_label_groups()) {
+                // All labels of a group have the same transitions, so lg_1 is only checked once against lg_2
+                std::vector<std::pair<int, int>> pending;
+                for (int l2 : lts.get_labels(lg_2)) {
                     for (int l1 : lts.get_labels(lg_1)) {
-
                         if (l1 != l2 && simulates(l1, l2, factor)) {
-                            //std::log << "Check " << l1 << " " << l2 << std::endl;
-                            //std::log << "Num transitions: " << lts.get_transitions_label(l1).size()
-                            //		    << " " << lts.get_transitions_label(l2).size() << std::endl;
-                            //Check if it really simulates
-                            //For each transition s--l2-->t, and every label l1 that dominates
-                            //l2, exist s--l1-->t', t <= t'?
-                            for (const auto &tr: lts.get_transitions_label(l2)) {
-                                bool found = false;
-                                //TODO (efficiency): for(auto tr2 : lts.get_transitions_for_label_src(l1, tr.src)){
-                                for (const auto &tr2: lts.get_transitions_label(l1)) {
-                                    if (tr2.src == tr.src &&
-                                        sim.simulates(tr2.target, tr.target)) {
-                                        found = true;
-                                        break; //Stop checking this tr
-                                        }
-                                }
-                                if (!found) {
-                                    //std::log << "Not sim " << l1 << " " << l2 << " " << i << std::endl;
-                                    set_not_simulates(l1, l2, factor);
-                                    changes = true;
-                                    break; //Stop checking trs of l1
-                                }
-                            }
+                            pending.emplace_back(l1, l2);
                         }
                     }
                 }
+                //Check if it really simulates
+                //For each transition s--l2-->t, and every label l1 that dominates
+                //l2, exist s--l1-->t', t <= t'?
+                if (!pending.empty() && !group_simulates(lts, lg_1, lg_2, sim)) {
+                    update.not_simulates.insert(update.not_simulates.end(), pending.begin(), pending.end());
+                }
+            }
+
+            //Is l2 simulated by irrelevant_labels in lts?
+            const auto& labels_2 = lts.get_labels(lg_2);
+            if (std::ranges::any_of(labels_2, [&](int l2) { return simulated_by_irrelevant[l2][factor]; }) &&
+                !noop_simulates_group(lts, lg_2, sim)) {
+                for (int l2 : labels_2) {
+                    if (simulated_by_irrelevant[l2][factor]) {
+                        update.not_simulated_by_irrelevant.push_back(l2);
+                    }
+                }
+            }
 
-                //Is l2 simulated by irrelevant_labels in lts?
-                for (auto tr: lts.get_transitions_label(l2)) {
-                    if (simulated_by_irrelevant[l2][factor] &&
-                        !sim.simulates(tr.src, tr.target)) {
-                        changes |= set_not_simulated_by_irrelevant(l2, factor);
-                        for (int l: lts.get_irrelevant_labels()) {
-                            if (simulates(l, l2, factor)) {
-                                changes = true;
-                                set_not_simulates(l, l2, factor);
-                            }
-                        }
-                        break;
+            //Does l2 simulates irrelevant_labels in lts?
+            if (std::ranges::any_of(labels_2, [&](int l2) { return simulates_irrelevant[l2][factor]; }) &&
+                !group_simulates_noop(lts, lg_2, sim)) {
+                for (int l2 : labels_2) {
+                    if (simulates_irrelevant[l2][factor]) {
+                        update.not_simulates_irrelevant.push_back(l2);
+                    }
+                }
+            }
+        }
+        return update;
+    }
+
+    bool DenseLabelRelation::apply_factor_update(int factor, const fts::LabelledTransitionSystem& lts, const FactorUpdate& update) {
+        bool changes = false;
+        for (const auto& [l1, l2] : update.not_simulates) {
+            if (simulates(l1, l2, factor)) {
+                set_not_simulates(l1, l2, factor);
+                changes = true;
+            }
+        }
+
+        for (int l2 : update.not_simulated_by_irrelevant) {
+            changes |= set_not_simulated_by_irrelevant(l2, factor);
+            for (int l: lts.get_irrelevant_labels()) {
+                if (simulates(l, l2, factor)) {
+                    changes = true;
+                    set_not_simulates(l, l2, factor);
+                }
+            }
+        }
+
+        for (int l2 : update.not_simulates_irrelevant) {
+            //log << "Not simulates irrelevant: " << l2  << " in " << i << endl;
+            simulates_irrelevant[l2][factor] = false;
+            for (int l: lts.get_irrelevant_labels()) {
+                if (simulates(l2, l, factor)) {
+                    set_not_simulates(l2, l, factor);
+                    changes = true;
+                }
+            }
+        }
+
+        return changes;
+    }
+
+    LabelRelationChanges DenseLabelRelation::update_factor_incremental(int factor, const fts::FTSTask& fts_task, const FactorDominanceRelation& sim,
+                                                                       const std::vector<std::pair<int, int>>& removed_simulations) {
+        const fts::LabelledTransitionSystem& lts = fts_task.get_factor(factor);
+
+        // Collect the checks that depend on some removed pair (t, s)
+        std::set<std::pair<int, int>> group_pairs; // (lg1, lg2) with s''--lg1-->t and s''--lg2-->s
+        std::set<int> groups_noop; // lg with t--lg-->s
+        std::set<int> groups_simulating_noop; // lg with s--lg-->t
+        for (const auto& [t, s] : removed_simulations) {
+            for (const auto& tr2 : lts.get_transitions_to(s)) {
+                if (!lts.is_relevant_label_group(tr2.label_group)) {
+                    continue;
+                }
+                for (const auto& tr1 : lts.get_transitions(tr2.src)) {
+                    if (tr1.target == t && lts.is_relevant_label_group(tr1.label_group)) {
+                        group_pairs.emplace(tr1.label_group.group, tr2.label_group.group);
+                    }
+                }
+                if (tr2.src == t) {
+                    groups_noop.insert(tr2.label_group.group);
+                }
+            }
+            for (const auto& tr : lts.get_transitions(s)) {
+                if (tr.target == t && lts.is_relevant_label_group(tr.label_group)) {
+                    groups_simulating_noop.insert(tr.label_group.group);
+                }
+            }
+        }
+
+        LabelRelationChanges changes;
+        for (const auto& [g1, g2] : group_pairs) {
+            fts::LabelGroup lg1(g1), lg2(g2);
+            auto pending_pairs = [&]() {
+                return std::ranges::any_of(lts.get_labels(lg2), [&](int l2) {
+                    return std::ranges::any_of(lts.get_labels(lg1), [&](int l1) {
+                        return l1 != l2 && simulates(l1, l2, factor);
+                    });
+                });
+            };
+            if (!pending_pairs()) {
+                continue;
+            }
+            ++changes.checked_pairs;
+            if (!group_simulates(lts, lg1, lg2, sim)) {
+                for (int l2 : lts.get_labels(lg2)) {
+                    for (int l1 : lts.get_labels(lg1)) {
+                        if (l1 != l2 && simulates(l1, l2, factor)) {
+                            set_not_simulates(l1, l2, factor);
+                            changes.dominated_labels.push_back(l2);
                         }
+                    }
                 }
+            }
+        }
 
-                //Does l2 simulates irrelevant_labels in lts?
-                if (simulates_irrelevant[l2][factor]) {
-                    for (int s = 0; s < lts.size(); s++) {
-                        bool found = false;
-                        for (const auto &tr: lts.get_transitions_label(l2)) {
-                            if (tr.src == s && sim.simulates(tr.target, tr.src)) {
-                                found = true;
-                                break;
-                            }
+        for (int g : groups_noop) {
+            fts::LabelGroup lg(g);
+            if (std::ranges::none_of(lts.get_labels(lg), [&](int l) { return simulated_by_irrelevant[l][factor]; })) {
+                continue;
+            }
+            ++changes.checked_pairs;
+            if (!noop_simulates_group(lts, lg, sim)) {
+                for (int l2 : lts.get_labels(lg)) {
+                    if (!simulated_by_irrelevant[l2][factor]) {
+                        continue;
+                    }
+                    if (set_not_simulated_by_irrelevant(l2, factor)) {
+                        changes.dominated_labels.push_back(l2);
+                    }
+                    for (int l: lts.get_irrelevant_labels()) {
+                        if (simulates(l, l2, factor)) {
+                            set_not_simulates(l, l2, factor);
+                            changes.dominated_labels.push_back(l2);
                         }
-                        if (!found) {
-                            //log << "Not simulates irrelevant: " << l2  << " in " << i << endl;
-                            simulates_irrelevant[l2][factor] = false;
-                            for (int l: lts.get_irrelevant_labels()) {
-                                if (simulates(l2, l, factor)) {
-                                    set_not_simulates(l2, l, factor);
-                                    changes = true;
-                                }
-                            }
-                            break;
+                    }
+                }
+            }
+        }
+
+        for (int g : groups_simulating_noop) {
+            fts::LabelGroup lg(g);
+            if (std::ranges::none_of(lts.get_labels(lg), [&](int l) { return simulates_irrelevant[l][factor]; })) {
+                continue;
+            }
+            ++changes.checked_pairs;
+            if (!group_simulates_noop(lts, lg, sim)) {
+                for (int l2 : lts.get_labels(lg)) {
+                    if (!simulates_irrelevant[l2][factor]) {
+                        continue;
+                    }
+                    simulates_irrelevant[l2][factor] = false;
+                    for (int l: lts.get_irrelevant_labels()) {
+                        if (simulates(l2, l, factor)) {
+                            set_not_simulates(l2, l, factor);
+                            changes.dominated_labels.push_back(l);
                         }
                     }
                 }
             }
         }
 
+        std::ranges::sort(changes.dominated_labels);
+        const auto duplicates = std::ranges::unique(changes.dominated_labels);
+        changes.dominated_labels.erase(duplicates.begin(), duplicates.end());
         return changes;
     }
 
@@ -3,8 +3,14 @@
 
 #include "label_relation.h"
 
+#include <utility>
 #include <vector>
 
+namespace fts {
+    class LabelGroup;
+    class LabelledTransitionSystem;
+}
+
 namespace dominance {
     class AllNoneFactorIndex;
 
@@ -29,6 +35,18 @@ namespace dominance {
 
         inline bool set_not_simulated_by_irrelevant(int l, int lts);
 
+        // Changes found by checking one factor, which are applied afterwards
+        struct FactorUpdate {
+            // Pairs (l1, l2) where l1 no longer simulates l2
+            std::vector<std::pair<int, int>> not_simulates;
+            std::vector<int> not_simulated_by_irrelevant;
+            std::vector<int> not_simulates_irrelevant;
+        };
+
+        // Only reads the relation, so it can be called concurrently for different factors
+        [[nodiscard]] FactorUpdate compute_factor_update(int factor, const fts::LabelledTransitionSystem& lts, const FactorDominanceRelation& sim) const;
+        bool apply_factor_update(int factor, const fts::LabelledTransitionSystem& lts, const FactorUpdate& update);
+
     public:
 
         [[nodiscard]] bool label_dominates_label_in_all_other(int factor, const fts::FTSTask& fts_task, int l1, int l2) const override;
@@ -37,6 +55,11 @@ namespace dominance {
 
         bool update_factor(int factor, const fts::FTSTask& fts_task, const FactorDominanceRelation& sim) override;
 
+        std::function<bool()> collect_factor_update(int factor, const fts::FTSTask& fts_task, const FactorDominanceRelation& sim) override;
+
+        LabelRelationChanges update_factor_incremental(int factor, const fts::FTSTask& fts_task, const FactorDominanceRelation& sim,
+                                                       const std::vector<std::pair<int, int>>& removed_simulations) override;
+
         explicit DenseLabelRelation(const fts::FTSTask & fts_task);
 
         inline int get_num_labels() const;
@@ -1,8 +1,16 @@
 #include "dominance_analysis.h"
 
+#include "label_relation.h"
+#include "state_dominance_relation.h"
+
 #include "../plugins/plugin.h"
 
 namespace dominance {
+    std::unique_ptr<StateDominanceRelation> DominanceAnalysis::restore_dominance_relation(
+            const fts::FTSTask &, const std::vector<std::vector<std::pair<int, int>>> &) {
+        return nullptr;
+    }
+
     static class DominanceAnalysisCategoryPlugin : public plugins::TypedCategoryPlugin<DominanceAnalysis> {
     public:
         DominanceAnalysisCategoryPlugin() : TypedCategoryPlugin("DominanceAnalysis") {
@@ -2,6 +2,8 @@
 #define DOMINANCE_DOMINANCE_ANALYSIS_H
 
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace fts {
     class FTSTask;
@@ -11,10 +13,28 @@ namespace dominance {
     class StateDominanceRelation;
 
     class DominanceAnalysis {
+        // Configuration string of the component, which identifies its results in the DominanceCache
+        std::string config;
     public:
         virtual ~DominanceAnalysis() = default;
 
+        void set_config(const std::string &config_) {
+            config = config_;
+        }
+
+        const std::string &get_config() const {
+            return config;
+        }
+
         virtual std::unique_ptr<StateDominanceRelation> compute_dominance_relation(const fts::FTSTask &task) = 0;
+
+        /*
+         * Rebuilds the relation computed by compute_dominance_relation from its simulation pairs (s, t) in each
+         * factor, e.g. when reading it from a cache. Returns nullptr if the analysis does not support it or the pairs
+         * cannot come from it.
+         */
+        virtual std::unique_ptr<StateDominanceRelation> restore_dominance_relation(
+                const fts::FTSTask &task, const std::vector<std::vector<std::pair<int, int>>> &simulations);
     };
 
 }
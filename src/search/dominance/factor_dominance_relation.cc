@@ -1,9 +1,13 @@
 #include "factor_dominance_relation.h"
 
+#include "label_relation.h"
+#include "../factored_transition_system/fts_task.h"
 #include "../factored_transition_system/labelled_transition_system.h"
 #include "../utils/logging.h"
 #include "../plugins/plugin.h"
 
+#include <algorithm>
+
 using namespace std;
 using fts::LabelledTransitionSystem;
 
@@ -21,6 +25,54 @@ namespace dominance {
         return true;
     }
 
+    bool FactorDominanceRelation::update(int factor, const fts::FTSTask& fts_task, const LabelRelation& label_dominance) {
+        bool changes = true;
+        bool any_changes = false;
+        while (changes) {
+            changes = remove_simulations_if([&](int t, int s) {
+                return !check_simulation(factor, fts_task, label_dominance, t, s);
+            });
+            any_changes |= changes;
+        }
+        return any_changes;
+    }
+
+    bool FactorDominanceRelation::check_simulation(int factor, const fts::FTSTask& fts_task, const LabelRelation& label_dominance, int t, int s) const {
+        const LabelledTransitionSystem& lts = fts_task.get_factor(factor);
+        //log << "Checking states " << lts->name(s) << " and " << lts->name(t) << endl;
+        //Check if really t simulates s
+        //for each transition s--l->s':
+        // a) with noop t >= s' and l dominated by noop?
+        // b) exist t--l'-->t', t' >= s' and l dominated by l'?
+        return !lts.applyPostSrc(s, [&](const auto &trs) {
+            //log << "Checking transition " << s << " to " << trs.target << std::endl;
+
+            const std::vector<int> &labels_trs = lts.get_labels(trs.label_group);
+         //   assert(!labels_trs.empty());
+            for (int labels_tr : labels_trs) {
+                //log << "Checking label " << labels_trs[i] << " to " << trs.target << std::endl;
+                if (simulates(t, trs.target) && label_dominance.noop_dominates_label_in_all_other(factor, fts_task, labels_tr)) {
+                    continue;
+                }
+                bool found =
+                        lts.applyPostSrcGrouped(t, [&](fts::LabelGroup lg_t, std::span<const int> targets_t) {
+                            return std::ranges::any_of(targets_t, [&](int target_t) {
+                                       return simulates(target_t, trs.target);
+                                   }) &&
+                                   std::ranges::any_of(lts.get_labels(lg_t), [&](int label_trt) {
+                                       return label_dominance.label_dominates_label_in_all_other(factor, fts_task, label_trt, labels_tr);
+                                   });
+                        });
+
+                if (!found) {
+                    return true;
+                }
+            }
+
+            return false;
+        });
+    }
+
     void FactorDominanceRelation::dump(utils::LogProxy& log, const LabelledTransitionSystem& lts) const {
         log << "SIMREL:" << std::endl;
         for (int j = 0; j < num_states; ++j) {
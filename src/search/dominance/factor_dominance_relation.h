@@ -7,10 +7,13 @@
 #include "../utils/logging.h"
 
 namespace fts {
+    class FTSTask;
     class LabelledTransitionSystem;
 }
 
 namespace dominance {
+    class LabelRelation;
+
     /**
      * FactorDominanceRelation is abstract and represents the simulation relation between states in a single LTS.
      */
@@ -27,6 +30,9 @@ namespace dominance {
         [[nodiscard]] virtual inline bool simulates(int s, int t) const = 0;
         [[nodiscard]] virtual inline bool similar(int s, int t) const = 0;
 
+        // Removes the simulation: s no longer simulates t
+        virtual void remove(int s, int t) = 0;
+
         [[nodiscard]] virtual bool is_identity() const;
 
         virtual void dump(utils::LogProxy &log, const fts::LabelledTransitionSystem& lts) const;
@@ -48,6 +54,19 @@ namespace dominance {
          * @return True if any simulation was removed, false otherwise.
          */
         virtual bool remove_simulations_if(std::function<bool(int s, int t)> &&f) = 0;
+
+        /**
+         * Remove simulations that are not justified by the transitions of the factor and the label relation, until
+         * a fixpoint is reached. The default implementation checks every pair through remove_simulations_if.
+         * @return True if any simulation was removed, false otherwise.
+         */
+        virtual bool update(int factor, const fts::FTSTask& fts_task, const LabelRelation& label_dominance);
+
+        /**
+         * Checks whether t can still simulate s w.r.t. the current relation, i.e., whether t can respond to every
+         * transition of s either by staying or by a transition with a dominating label.
+         */
+        [[nodiscard]] bool check_simulation(int factor, const fts::FTSTask& fts_task, const LabelRelation& label_dominance, int t, int s) const;
     };
 
 
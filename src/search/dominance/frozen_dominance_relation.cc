@@ -0,0 +1,46 @@
+#include "frozen_dominance_relation.h"
+
+#include "factor_dominance_relation.h"
+#include "state_dominance_relation.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace dominance {
+    FrozenDominanceRelation::FrozenDominanceRelation(const StateDominanceRelation &relation)
+        : num_factors(relation.size()) {
+        size_t total_words = 0;
+        factor_offset.reserve(num_factors);
+        words_per_row.reserve(num_factors);
+        for (int factor = 0; factor < num_factors; ++factor) {
+            int num_states = relation[factor].get_num_states();
+            factor_offset.push_back(total_words);
+            words_per_row.push_back((num_states + BITS_PER_WORD - 1) / BITS_PER_WORD);
+            total_words += static_cast<size_t>(num_states) * words_per_row.back();
+        }
+
+        arena.resize(total_words, 0);
+        for (int factor = 0; factor < num_factors; ++factor) {
+            relation[factor].apply_to_simulations_until([&](int s, int t) {
+                Word *bits = arena.data() + factor_offset[factor] + static_cast<size_t>(t) * words_per_row[factor];
+                bits[s / BITS_PER_WORD] |= Word(1) << (s % BITS_PER_WORD);
+                return false;
+            });
+        }
+    }
+
+    bool FrozenDominanceRelation::any_dominates(span<const int> states, span<const int> s) const {
+        if (num_factors == 0) {
+            return false;
+        }
+        assert(states.size() % num_factors == 0);
+        for (size_t begin = 0; begin < states.size(); begin += num_factors) {
+            if (dominates(states.subspan(begin, num_factors), s)) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
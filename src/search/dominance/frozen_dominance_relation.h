@@ -0,0 +1,63 @@
+#ifndef DOMINANCE_FROZEN_DOMINANCE_RELATION_H
+#define DOMINANCE_FROZEN_DOMINANCE_RELATION_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace dominance {
+    class StateDominanceRelation;
+
+    /*
+     * Read-only copy of a StateDominanceRelation for the hot paths of pruning. The relations of all factors are
+     * flattened into a single bit arena: for each factor, one row per state t with a bit for each state s that
+     * simulates t. All queries are non-virtual and inline.
+     *
+     * A single copy is built by DominancePruning and shared with its database.
+     */
+    class FrozenDominanceRelation {
+        using Word = uint64_t;
+        static constexpr int BITS_PER_WORD = 64;
+
+        int num_factors;
+        // First word of the rows of each factor, and number of words of each row
+        std::vector<size_t> factor_offset;
+        std::vector<int> words_per_row;
+        std::vector<Word> arena;
+
+        [[nodiscard]] const Word *row(int factor, int t) const {
+            return arena.data() + factor_offset[factor] + static_cast<size_t>(t) * words_per_row[factor];
+        }
+
+    public:
+        explicit FrozenDominanceRelation(const StateDominanceRelation &relation);
+
+        [[nodiscard]] int get_num_factors() const {
+            return num_factors;
+        }
+
+        // s simulates t in the factor
+        [[nodiscard]] bool simulates(int factor, int s, int t) const {
+            return (row(factor, t)[s / BITS_PER_WORD] >> (s % BITS_PER_WORD)) & 1;
+        }
+
+        // t dominates s: t simulates s in every factor
+        [[nodiscard]] bool dominates(std::span<const int> t, std::span<const int> s) const {
+            for (int factor = 0; factor < num_factors; ++factor) {
+                if (!simulates(factor, t[factor], s[factor])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Whether some of the states, stored one after another with num_factors values each, dominates s
+        [[nodiscard]] bool any_dominates(std::span<const int> states, std::span<const int> s) const;
+
+        [[nodiscard]] size_t get_memory_in_bytes() const {
+            return arena.size() * sizeof(Word);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,211 @@
+#include "incremental_ld_simulation.h"
+
+#include "factor_dominance_relation.h"
+#include "label_relation.h"
+#include "ld_simulation.h"
+#include "state_dominance_relation.h"
+#include "../factored_transition_system/fts_task.h"
+
+#include "../plugins/plugin.h"
+#include "../utils/markup.h"
+
+#include <algorithm>
+#include <deque>
+#include <numeric>
+
+using std::vector;
+
+namespace dominance {
+    IncrementalLDSimulation::IncrementalLDSimulation(utils::Verbosity verbosity, std::shared_ptr<FactorDominanceRelationFactory> factor_dominance_relation_factory,
+                                                     std::shared_ptr<LabelRelationFactory> label_relation_factory) :
+            log(utils::get_log_for_verbosity(verbosity)), factor_dominance_relation_factory(std::move(factor_dominance_relation_factory)),
+            label_relation_factory(std::move(label_relation_factory)) {
+    }
+
+    vector<std::pair<int, int>> IncrementalLDSimulation::refine_factor(int factor, const fts::FTSTask &task, const LabelRelation &label_relation,
+                                                                      FactorDominanceRelation &local_relation, const vector<int> &dirty_states,
+                                                                      RoundStatistics &statistics) const {
+        const fts::LabelledTransitionSystem &lts = task.get_factor(factor);
+        const size_t num_states = lts.size();
+
+        vector<bool> queued(num_states * num_states, false);
+        std::deque<std::pair<int, int>> worklist;
+        auto enqueue = [&](int t, int s) {
+            size_t index = t * num_states + s;
+            if (t != s && !queued[index] && local_relation.simulates(t, s)) {
+                queued[index] = true;
+                worklist.emplace_back(t, s);
+            }
+        };
+
+        for (int s : dirty_states) {
+            for (int t = 0; t < lts.size(); ++t) {
+                enqueue(t, s);
+            }
+        }
+
+        vector<std::pair<int, int>> removed;
+        while (!worklist.empty()) {
+            const auto [t, s] = worklist.front();
+            worklist.pop_front();
+            queued[t * num_states + s] = false;
+            ++statistics.checked_state_pairs;
+
+            if (!local_relation.check_simulation(factor, task, label_relation, t, s)) {
+                local_relation.remove(t, s);
+                removed.emplace_back(t, s);
+
+                // Pairs (t', s') with s'--l-->s may have used t >= s to respond by staying in t or with t'--l'-->t.
+                // Transitions of irrelevant label groups are always answered with the same self-loop.
+                for (const auto &tr_s : lts.get_transitions_to(s)) {
+                    if (!lts.is_relevant_label_group(tr_s.label_group)) {
+                        continue;
+                    }
+                    enqueue(t, tr_s.src);
+                    for (const auto &tr_t : lts.get_transitions_to(t)) {
+                        enqueue(tr_t.src, tr_s.src);
+                    }
+                }
+            }
+        }
+        statistics.removed_state_pairs += removed.size();
+        return removed;
+    }
+
+    std::unique_ptr<StateDominanceRelation> IncrementalLDSimulation::compute_dominance_relation(const fts::FTSTask &task) {
+        utils::Timer t;
+        const int num_factors = task.get_num_variables();
+
+        vector<std::unique_ptr<FactorDominanceRelation>> local_relations;
+        local_relations.reserve(num_factors);
+        for (const auto & lts: task.get_factors()) {
+            local_relations.push_back(factor_dominance_relation_factory->create(*lts));
+        }
+
+        log << "Initialize label dominance: " << task.get_num_labels() << " labels " << num_factors << " systems." << std::endl;
+        std::unique_ptr<LabelRelation> label_relation = label_relation_factory->create(task, log);
+        update_label_relation(*label_relation, task, local_relations);
+        log << "Init incremental LDSim in " << t() << std::endl;
+
+        // In the first round, all pairs of states are checked
+        vector<vector<int>> dirty_states(num_factors);
+        for (int i = 0; i < num_factors; ++i) {
+            dirty_states[i].resize(task.get_factor(i).size());
+            std::iota(dirty_states[i].begin(), dirty_states[i].end(), 0);
+        }
+
+        RoundStatistics total;
+        int round = 0;
+        while (std::ranges::any_of(dirty_states, [](const vector<int> &states) { return !states.empty(); })) {
+            RoundStatistics statistics;
+            vector<vector<std::pair<int, int>>> removed(num_factors);
+            for (int i = 0; i < num_factors; ++i) {
+                removed[i] = refine_factor(i, task, *label_relation, *local_relations[i], dirty_states[i], statistics);
+                dirty_states[i].clear();
+            }
+
+            vector<bool> changed_label(task.get_num_labels(), false);
+            for (int i = 0; i < num_factors; ++i) {
+                if (removed[i].empty()) {
+                    continue;
+                }
+                LabelRelationChanges changes = label_relation->update_factor_incremental(i, task, *local_relations[i], removed[i]);
+                statistics.checked_label_pairs += changes.checked_pairs;
+                for (int l : changes.dominated_labels) {
+                    if (!changed_label[l]) {
+                        changed_label[l] = true;
+                        ++statistics.changed_labels;
+                    }
+                }
+            }
+
+            // Pairs (t, s) must be re-checked if s has a transition with a label whose dominating labels changed
+            if (statistics.changed_labels > 0) {
+                for (int i = 0; i < num_factors; ++i) {
+                    const fts::LabelledTransitionSystem &lts = task.get_factor(i);
+                    vector<bool> dirty(lts.size(), false);
+                    for (fts::LabelGroup lg : lts.get_relevant_label_groups()) {
+                        if (std::ranges::any_of(lts.get_labels(lg), [&](int l) { return changed_label[l]; })) {
+                            for (const auto &tr : lts.get_transitions_label_group(lg)) {
+                                dirty[tr.src] = true;
+                            }
+                        }
+                    }
+                    for (int s = 0; s < lts.size(); ++s) {
+                        if (dirty[s]) {
+                            dirty_states[i].push_back(s);
+                        }
+                    }
+                }
+            }
+
+            if (log.is_at_least_verbose()) {
+                log << "Round " << round << ": checked " << statistics.checked_state_pairs << " state pairs, removed "
+                    << statistics.removed_state_pairs << ", checked " << statistics.checked_label_pairs << " label pairs, "
+                    << statistics.changed_labels << " labels changed: " << t() << std::endl;
+            }
+            total.checked_state_pairs += statistics.checked_state_pairs;
+            total.removed_state_pairs += statistics.removed_state_pairs;
+            total.checked_label_pairs += statistics.checked_label_pairs;
+            total.changed_labels += statistics.changed_labels;
+            ++round;
+        }
+
+        log << "Incremental LDSimulation finished after " << round << " rounds: " << t() << std::endl;
+        log << "Checked " << total.checked_state_pairs << " state pairs (" << total.removed_state_pairs << " removed) and "
+            << total.checked_label_pairs << " label pairs" << std::endl;
+
+#ifndef NDEBUG
+        for (const auto& [factor, sim] : std::views::enumerate(local_relations)) {
+            sim->dump(log, task.get_factor(factor));
+        }
+        log << "Label relation: " << std::endl;
+
+        label_relation->dump(log, task);
+#endif
+        return std::make_unique<StateDominanceRelation>(std::move(local_relations), label_relation);
+    }
+
+    std::unique_ptr<StateDominanceRelation> IncrementalLDSimulation::restore_dominance_relation(
+            const fts::FTSTask &task, const vector<vector<std::pair<int, int>>> &simulations) {
+        // Both analyses compute the same relation
+        return restore_ld_simulation(task, *factor_dominance_relation_factory, *label_relation_factory, simulations, log);
+    }
+
+    class IncrementalLDSimulationFeature
+            : public plugins::TypedFeature<DominanceAnalysis, IncrementalLDSimulation> {
+    public:
+        IncrementalLDSimulationFeature() : TypedFeature("incremental_ld_simulation") {
+            document_title("Incremental LDSimulation");
+
+            document_synopsis(
+                    "Computes the same relation as ld_simulation, but uses a worklist so that each iteration only "
+                    "re-checks the pairs of states and labels whose inputs changed. This only pays off with label "
+                    "relations that support incremental updates (dense_lr()); with other label relations, every "
+                    "change of the label relation re-checks all states with transitions of the changed labels.");
+            document_language_support("action costs", "supported");
+            document_language_support("conditional effects", "not supported");
+            document_language_support("axioms", "not supported");
+
+            add_option<std::shared_ptr<FactorDominanceRelationFactory>>("fdr",
+                                                       "The data structure to store the factor dominance relation",
+                                                       "dense_fdr()");
+            add_option<std::shared_ptr<LabelRelationFactory>>("lr",
+                                                       "The data structure to store the label relation",
+                                                       "dense_lr()");
+
+            utils::add_log_options_to_feature(*this);
+        }
+
+        virtual std::shared_ptr<IncrementalLDSimulation> create_component(const plugins::Options &opts) const override {
+            auto analysis = plugins::make_shared_from_arg_tuples<IncrementalLDSimulation>(
+                    utils::get_log_arguments_from_options(opts),
+                    opts.get<std::shared_ptr<FactorDominanceRelationFactory>>("fdr"),
+                    opts.get<std::shared_ptr<LabelRelationFactory>>("lr"));
+            analysis->set_config(opts.get_unparsed_config());
+            return analysis;
+        }
+    };
+
+    static plugins::FeaturePlugin<IncrementalLDSimulationFeature> _plugin;
+}
@@ -0,0 +1,55 @@
+#ifndef DOMINANCE_INCREMENTAL_LD_SIMULATION_H
+#define DOMINANCE_INCREMENTAL_LD_SIMULATION_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include "../utils/logging.h"
+
+#include "dominance_analysis.h"
+
+namespace fts {
+    class FTSTask;
+}
+
+namespace dominance {
+    class FactorDominanceRelationFactory;
+    class FactorDominanceRelation;
+    class LabelRelation;
+    class LabelRelationFactory;
+
+    /*
+     * Computes the same relation as LDSimulation, but instead of re-checking every pair of states and labels in each
+     * iteration, it keeps a worklist of the pairs whose inputs changed (in the style of Henzinger, Henzinger and
+     * Kopke). When t no longer simulates s in a factor, only the pairs (t', s') with s'--l-->s and t'--l'-->t (or
+     * t' = t) are re-checked, and the label relation only re-checks the label pairs that depended on (t, s). When
+     * the label relation changes for a label l, all pairs (t, s) where s has a transition with l are re-checked.
+     */
+    class IncrementalLDSimulation : public DominanceAnalysis {
+        struct RoundStatistics {
+            long long checked_state_pairs = 0;
+            long long removed_state_pairs = 0;
+            long long checked_label_pairs = 0;
+            long long changed_labels = 0;
+        };
+
+        utils::LogProxy log;
+        std::shared_ptr<FactorDominanceRelationFactory> factor_dominance_relation_factory;
+        std::shared_ptr<LabelRelationFactory> label_relation_factory;
+
+        // Processes the worklist of a factor until no more pairs are removed. Returns the removed pairs (t, s).
+        std::vector<std::pair<int, int>> refine_factor(int factor, const fts::FTSTask &task, const LabelRelation &label_relation,
+                                                       FactorDominanceRelation &local_relation, const std::vector<int> &dirty_states,
+                                                       RoundStatistics &statistics) const;
+    public:
+        IncrementalLDSimulation(utils::Verbosity verbosity, std::shared_ptr<FactorDominanceRelationFactory> factor_dominance_relation_factory,
+                                std::shared_ptr<LabelRelationFactory> label_relation_factory);
+
+        virtual ~IncrementalLDSimulation() = default;
+        std::unique_ptr<StateDominanceRelation> compute_dominance_relation(const fts::FTSTask &task) override;
+        std::unique_ptr<StateDominanceRelation> restore_dominance_relation(
+                const fts::FTSTask &task, const std::vector<std::vector<std::pair<int, int>>> &simulations) override;
+    };
+}
+
+#endif
@@ -0,0 +1,357 @@
+#include "label_class_relation.h"
+
+#include "factor_dominance_relation.h"
+#include "../factored_transition_system/fts_task.h"
+#include "../factored_transition_system/labelled_transition_system.h"
+#include "../plugins/plugin.h"
+#include "../utils/hash.h"
+#include "../utils/logging.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+
+using namespace std;
+using fts::LabelGroup;
+using fts::LabelledTransitionSystem;
+
+namespace dominance {
+    LabelClassRelation::LabelClassRelation(const fts::FTSTask& fts_task, utils::LogProxy& log) : LabelRelation(fts_task.get_num_labels()),
+        num_factors(fts_task.get_num_variables()) {
+        compute_label_classes(fts_task);
+
+        simulated_by_irrelevant.resize(num_factors);
+        simulates_irrelevant.resize(num_factors);
+        for (int factor = 0; factor < num_factors; ++factor) {
+            int num_label_groups = fts_task.get_factor(factor).get_num_label_groups();
+            simulated_by_irrelevant[factor].resize(num_label_groups, true);
+            simulates_irrelevant[factor].resize(num_label_groups, true);
+        }
+        dominated_by_noop_in.resize(get_num_label_classes(), AllNoneFactorIndex::all_factors());
+
+        initialize_dominating_classes(fts_task);
+
+        if (log.is_at_least_verbose()) {
+            size_t num_entries = 0;
+            for (const auto& row : dominating_classes) {
+                num_entries += row.size();
+            }
+            // The rows only shrink during the updates, so this is the peak size of the relation
+            log << "Label class relation: " << num_labels << " labels in " << get_num_label_classes()
+                << " classes, " << num_entries << " dominance candidates ("
+                << estimate_memory_in_bytes() / 1024 << " KB)" << endl;
+            log << "Peak memory after label class relation: " << utils::get_peak_memory_in_kb() << " KB" << endl;
+        }
+    }
+
+    void LabelClassRelation::compute_label_classes(const fts::FTSTask& fts_task) {
+        // Key of a label: its cost and the relevant label group of each factor where it is relevant
+        utils::HashMap<vector<int>, int> class_of_key;
+        class_of_label.resize(num_labels);
+        for (int l = 0; l < num_labels; ++l) {
+            vector<int> key {fts_task.get_label_cost(l)};
+            for (int factor = 0; factor < num_factors; ++factor) {
+                const LabelledTransitionSystem& lts = fts_task.get_factor(factor);
+                if (lts.is_relevant_label(l)) {
+                    key.push_back(factor);
+                    key.push_back(lts.get_group_label(l).group);
+                }
+            }
+            auto [it, inserted] = class_of_key.try_emplace(std::move(key), representative.size());
+            if (inserted) {
+                representative.push_back(l);
+            }
+            class_of_label[l] = it->second;
+        }
+
+        int num_classes = get_num_label_classes();
+        class_label_begin.assign(num_classes + 1, 0);
+        for (int c : class_of_label) {
+            ++class_label_begin[c + 1];
+        }
+        for (int c = 0; c < num_classes; ++c) {
+            class_label_begin[c + 1] += class_label_begin[c];
+        }
+        labels_of_class.resize(num_labels);
+        vector<int> position(class_label_begin.begin(), class_label_begin.end() - 1);
+        for (int l = 0; l < num_labels; ++l) {
+            labels_of_class[position[class_of_label[l]]++] = l;
+        }
+
+        classes_of_group.resize(num_factors);
+        for (int factor = 0; factor < num_factors; ++factor) {
+            const LabelledTransitionSystem& lts = fts_task.get_factor(factor);
+            classes_of_group[factor].resize(lts.get_num_label_groups());
+            for (int c = 0; c < num_classes; ++c) {
+                LabelGroup lg = group_of_class(lts, c);
+                if (lts.is_relevant_label_group(lg)) {
+                    classes_of_group[factor][lg.group].push_back(c);
+                }
+            }
+        }
+    }
+
+    void LabelClassRelation::initialize_dominating_classes(const fts::FTSTask& fts_task) {
+        /*
+          Structural check in each factor (independent of the factor relation): if both classes are relevant, c1 must
+          be applicable in every state where c2 is applicable; if only c1 is relevant, it must dominate noop, so it
+          must be applicable in every state. Pairs that fail in two or more factors are never stored.
+        */
+        int num_classes = get_num_label_classes();
+        vector<vector<int>> relevant_factors(num_classes);
+        vector<vector<bool>> applicable_everywhere(num_factors);
+        // includes_sources[factor][lg1 * num_label_groups + lg2]: lg1 is applicable wherever lg2 is
+        vector<vector<bool>> includes_sources(num_factors);
+        for (int factor = 0; factor < num_factors; ++factor) {
+            const LabelledTransitionSystem& lts = fts_task.get_factor(factor);
+            int num_label_groups = lts.get_num_label_groups();
+            vector<vector<int>> sources(num_label_groups);
+            applicable_everywhere[factor].resize(num_label_groups, true);
+            for (LabelGroup lg : lts.get_relevant_label_groups()) {
+                for (const auto& tr : lts.get_transitions_label_group(lg)) {
+                    sources[lg.group].push_back(tr.src);
+                }
+                std::ranges::sort(sources[lg.group]);
+                const auto duplicates = std::ranges::unique(sources[lg.group]);
+                sources[lg.group].erase(duplicates.begin(), duplicates.end());
+                applicable_everywhere[factor][lg.group] = static_cast<int>(sources[lg.group].size()) == lts.size();
+                for (int c : classes_of_group[factor][lg.group]) {
+                    relevant_factors[c].push_back(factor);
+                }
+            }
+
+            includes_sources[factor].resize(static_cast<size_t>(num_label_groups) * num_label_groups, false);
+            for (LabelGroup lg1 : lts.get_relevant_label_groups()) {
+                for (LabelGroup lg2 : lts.get_relevant_label_groups()) {
+                    includes_sources[factor][lg1.group * num_label_groups + lg2.group] =
+                        std::ranges::includes(sources[lg1.group], sources[lg2.group]);
+                }
+            }
+        }
+
+        dominating_classes.resize(num_classes);
+        for (int c2 = 0; c2 < num_classes; ++c2) {
+            int cost_2 = fts_task.get_label_cost(representative[c2]);
+            for (int c1 = 0; c1 < num_classes; ++c1) {
+                if (c1 == c2 || fts_task.get_label_cost(representative[c1]) > cost_2) {
+                    continue;
+                }
+                AllNoneFactorIndex factors = AllNoneFactorIndex::all_factors();
+                for (int factor : relevant_factors[c2]) {
+                    const LabelledTransitionSystem& lts = fts_task.get_factor(factor);
+                    LabelGroup lg1 = group_of_class(lts, c1);
+                    LabelGroup lg2 = group_of_class(lts, c2);
+                    if (lts.is_relevant_label_group(lg1) &&
+                        !includes_sources[factor][lg1.group * lts.get_num_label_groups() + lg2.group] &&
+                        factors.remove(factor) && factors.is_none()) {
+                        break;
+                    }
+                }
+                for (int factor : relevant_factors[c1]) {
+                    if (factors.is_none()) {
+                        break;
+                    }
+                    const LabelledTransitionSystem& lts = fts_task.get_factor(factor);
+                    if (!lts.is_relevant_label_group(group_of_class(lts, c2)) &&
+                        !applicable_everywhere[factor][group_of_class(lts, c1).group]) {
+                        factors.remove(factor);
+                    }
+                }
+                if (!factors.is_none()) {
+                    dominating_classes[c2].push_back({c1, factors});
+                }
+            }
+            dominating_classes[c2].shrink_to_fit();
+        }
+    }
+
+    size_t LabelClassRelation::estimate_memory_in_bytes() const {
+        size_t bytes = (class_of_label.capacity() + representative.capacity() + class_label_begin.capacity() +
+                        labels_of_class.capacity()) * sizeof(int);
+        bytes += dominated_by_noop_in.capacity() * sizeof(AllNoneFactorIndex);
+        for (const auto& row : dominating_classes) {
+            bytes += sizeof(row) + row.capacity() * sizeof(DominatingClass);
+        }
+        for (const auto& factor_classes : classes_of_group) {
+            for (const auto& classes : factor_classes) {
+                bytes += sizeof(classes) + classes.capacity() * sizeof(int);
+            }
+        }
+        for (int factor = 0; factor < num_factors; ++factor) {
+            bytes += (simulated_by_irrelevant[factor].capacity() + simulates_irrelevant[factor].capacity()) / 8;
+        }
+        return bytes;
+    }
+
+    LabelGroup LabelClassRelation::group_of_class(const LabelledTransitionSystem& lts, int c) const {
+        return lts.get_group_label(representative[c]);
+    }
+
+    const LabelClassRelation::DominatingClass* LabelClassRelation::find_dominating_class(int c1, int c2) const {
+        const vector<DominatingClass>& row = dominating_classes[c2];
+        auto it = std::ranges::lower_bound(row, c1, {}, &DominatingClass::label_class);
+        if (it == row.end() || it->label_class != c1) {
+            return nullptr;
+        }
+        return &*it;
+    }
+
+    bool LabelClassRelation::label_dominates_label_in_all_other(int factor, const fts::FTSTask& /*fts_task*/, int l1, int l2) const {
+        int c1 = class_of_label[l1];
+        int c2 = class_of_label[l2];
+        if (c1 == c2) {
+            return true;
+        }
+        const DominatingClass* entry = find_dominating_class(c1, c2);
+        return entry && entry->factors.contains_all_except(factor);
+    }
+
+    bool LabelClassRelation::noop_dominates_label_in_all_other(int factor, const fts::FTSTask& /*fts_task*/, int l) const {
+        return dominated_by_noop_in[class_of_label[l]].contains_all_except(factor);
+    }
+
+    LabelClassRelation::FactorUpdate LabelClassRelation::compute_factor_update(int factor, const LabelledTransitionSystem& lts, const FactorDominanceRelation& sim) const {
+        FactorUpdate update;
+        // Result of group_simulates(lg1, lg2) for the current lg2: -1 unknown, 0 false, 1 true
+        vector<int> group_simulates_lg2(lts.get_num_label_groups());
+        for (LabelGroup lg_2 : lts.get_relevant_label_groups()) {
+            const vector<int>& classes_2 = classes_of_group[factor][lg_2.group];
+            std::ranges::fill(group_simulates_lg2, -1);
+            for (int c2 : classes_2) {
+                for (const DominatingClass& entry : dominating_classes[c2]) {
+                    LabelGroup lg_1 = group_of_class(lts, entry.label_class);
+                    // Irrelevant labels are handled with simulated_by_irrelevant
+                    if (!entry.factors.contains(factor) || !lts.is_relevant_label_group(lg_1)) {
+                        continue;
+                    }
+                    int& result = group_simulates_lg2[lg_1.group];
+                    if (result == -1) {
+                        result = group_simulates(lts, lg_1, lg_2, sim);
+                    }
+                    if (!result) {
+                        update.not_simulates.emplace_back(entry.label_class, c2);
+                    }
+                }
+            }
+
+            if (simulated_by_irrelevant[factor][lg_2.group] && !noop_simulates_group(lts, lg_2, sim)) {
+                update.not_simulated_by_irrelevant.push_back(lg_2.group);
+            }
+            if (simulates_irrelevant[factor][lg_2.group] && !group_simulates_noop(lts, lg_2, sim)) {
+                update.not_simulates_irrelevant.push_back(lg_2.group);
+            }
+        }
+        return update;
+    }
+
+    bool LabelClassRelation::apply_factor_update(int factor, const LabelledTransitionSystem& lts, const FactorUpdate& update,
+                                                 vector<int>* changed_classes) {
+        bool changes = false;
+        vector<bool> touched(get_num_label_classes(), false);
+        auto remove_factor = [&](DominatingClass& entry, int c2) {
+            if (entry.factors.remove(factor)) {
+                changes = true;
+                touched[c2] = true;
+            }
+        };
+
+        for (const auto& [c1, c2] : update.not_simulates) {
+            // The entry may have been removed by the update of another factor since the update was computed
+            auto& row = dominating_classes[c2];
+            auto it = std::ranges::lower_bound(row, c1, {}, &DominatingClass::label_class);
+            if (it != row.end() && it->label_class == c1) {
+                remove_factor(*it, c2);
+            }
+        }
+
+        for (int g : update.not_simulated_by_irrelevant) {
+            simulated_by_irrelevant[factor][g] = false;
+            for (int c2 : classes_of_group[factor][g]) {
+                if (dominated_by_noop_in[c2].remove(factor)) {
+                    changes = true;
+                    touched[c2] = true;
+                }
+                for (DominatingClass& entry : dominating_classes[c2]) {
+                    if (!lts.is_relevant_label_group(group_of_class(lts, entry.label_class))) {
+                        remove_factor(entry, c2);
+                    }
+                }
+            }
+        }
+
+        if (!update.not_simulates_irrelevant.empty()) {
+            for (int g : update.not_simulates_irrelevant) {
+                simulates_irrelevant[factor][g] = false;
+            }
+            // The classes of the group no longer dominate the classes that are irrelevant in the factor
+            for (int c2 = 0; c2 < get_num_label_classes(); ++c2) {
+                if (lts.is_relevant_label_group(group_of_class(lts, c2))) {
+                    continue;
+                }
+                for (DominatingClass& entry : dominating_classes[c2]) {
+                    LabelGroup lg_1 = group_of_class(lts, entry.label_class);
+                    if (lts.is_relevant_label_group(lg_1) && !simulates_irrelevant[factor][lg_1.group]) {
+                        remove_factor(entry, c2);
+                    }
+                }
+            }
+        }
+
+        for (int c2 = 0; c2 < get_num_label_classes(); ++c2) {
+            if (!touched[c2]) {
+                continue;
+            }
+            std::erase_if(dominating_classes[c2], [](const DominatingClass& entry) { return entry.factors.is_none(); });
+            if (changed_classes) {
+                changed_classes->push_back(c2);
+            }
+        }
+        return changes;
+    }
+
+    bool LabelClassRelation::update_factor(int factor, const fts::FTSTask& fts_task, const FactorDominanceRelation& sim) {
+        const LabelledTransitionSystem& lts = fts_task.get_factor(factor);
+        return apply_factor_update(factor, lts, compute_factor_update(factor, lts, sim));
+    }
+
+    std::function<bool()> LabelClassRelation::collect_factor_update(int factor, const fts::FTSTask& fts_task, const FactorDominanceRelation& sim) {
+        const LabelledTransitionSystem& lts = fts_task.get_factor(factor);
+        return [this, factor, &lts, update = compute_factor_update(factor, lts, sim)]() {
+            return apply_factor_update(factor, lts, update);
+        };
+    }
+
+    LabelRelationChanges LabelClassRelation::update_factor_incremental(int factor, const fts::FTSTask& fts_task, const FactorDominanceRelation& sim,
+                                                                       const vector<pair<int, int>>& /*removed_simulations*/) {
+        // The check is done per class, which is cheap enough to redo on each call, but only the labels of the classes
+        // that changed are reported
+        const LabelledTransitionSystem& lts = fts_task.get_factor(factor);
+        vector<int> changed_classes;
+        apply_factor_update(factor, lts, compute_factor_update(factor, lts, sim), &changed_classes);
+
+        LabelRelationChanges changes;
+        for (int c : changed_classes) {
+            changes.dominated_labels.insert(changes.dominated_labels.end(), labels_of_class.begin() + class_label_begin[c],
+                                            labels_of_class.begin() + class_label_begin[c + 1]);
+        }
+        std::ranges::sort(changes.dominated_labels);
+        return changes;
+    }
+
+    using LabelClassRelationFactory = LabelRelationFactoryImpl<LabelClassRelation>;
+    class LabelClassRelationFactoryFeature final : public plugins::TypedFeature<LabelRelationFactory, LabelClassRelationFactory> {
+    public:
+        LabelClassRelationFactoryFeature() : TypedFeature("class_lr") {
+            document_title("Label Class Relation");
+            document_synopsis("Stores the label relation between classes of equivalent labels (labels with the same cost "
+                              "and the same transitions in every factor). For each class, only the classes that may "
+                              "dominate it are stored, which avoids the quadratic number of label pairs of dense_lr() "
+                              "on tasks with many labels.");
+        }
+
+        [[nodiscard]] std::shared_ptr<LabelClassRelationFactory> create_component(const plugins::Options &opts) const override {
+            utils::unused_variable(opts);
+            return plugins::make_shared_from_arg_tuples<LabelClassRelationFactory>();
+        }
+    };
+    static plugins::FeaturePlugin<LabelClassRelationFactoryFeature> _class_plugin;
+}
@@ -0,0 +1,93 @@
+#ifndef DOMINANCE_LABEL_CLASS_RELATION_H
+#define DOMINANCE_LABEL_CLASS_RELATION_H
+
+#include "all_none_factor_index.h"
+#include "label_relation.h"
+
+#include <utility>
+#include <vector>
+
+namespace fts {
+    class LabelGroup;
+    class LabelledTransitionSystem;
+}
+
+namespace dominance {
+    /*
+     * Label relation between equivalence classes of labels. Two labels are equivalent if they have the same cost and
+     * belong to the same label group in every factor where they are relevant (all irrelevant label groups are self-loops
+     * everywhere, so they are not distinguished). Equivalent labels always dominate each other, so queries on labels
+     * are answered by mapping them to their classes and no per-label matrix is ever allocated.
+     *
+     * For each class c2, only the classes c1 that may dominate c2 in all factors except at most one are stored, in a
+     * sorted sparse row. The rows are initialized with a structural check that only depends on the LTSs (c1 must be
+     * applicable wherever c2 is), so the candidates that fail in two or more factors are never stored. Flags about
+     * noop are stored per label group and factor instead of per label and factor.
+     */
+    class LabelClassRelation : public LabelRelation {
+        struct DominatingClass {
+            int label_class;
+            AllNoneFactorIndex factors;
+        };
+
+        int num_factors;
+        std::vector<int> class_of_label;
+        // A label of each class, used to look up the label group of the class in each factor
+        std::vector<int> representative;
+        // Labels of each class in CSR format: labels_of_class[class_label_begin[c] .. class_label_begin[c + 1])
+        std::vector<int> class_label_begin;
+        std::vector<int> labels_of_class;
+        // classes_of_group[factor][lg]: classes whose labels belong to the relevant label group lg in factor
+        std::vector<std::vector<std::vector<int>>> classes_of_group;
+
+        // dominating_classes[c2]: classes c1 != c2 that dominate c2 in all factors except at most one, sorted by c1
+        std::vector<std::vector<DominatingClass>> dominating_classes;
+        std::vector<AllNoneFactorIndex> dominated_by_noop_in;
+
+        // Indicates whether the relevant label groups of each factor are dominated by noop (or irrelevant labels) in
+        // the factor, and whether they dominate noop
+        std::vector<std::vector<bool>> simulated_by_irrelevant;
+        std::vector<std::vector<bool>> simulates_irrelevant;
+
+        [[nodiscard]] fts::LabelGroup group_of_class(const fts::LabelledTransitionSystem& lts, int c) const;
+        [[nodiscard]] const DominatingClass* find_dominating_class(int c1, int c2) const;
+
+        void compute_label_classes(const fts::FTSTask& fts_task);
+        void initialize_dominating_classes(const fts::FTSTask& fts_task);
+        [[nodiscard]] size_t estimate_memory_in_bytes() const;
+
+        // Changes found by checking one factor, which are applied afterwards
+        struct FactorUpdate {
+            // Pairs of classes (c1, c2) where c1 no longer simulates c2
+            std::vector<std::pair<int, int>> not_simulates;
+            std::vector<int> not_simulated_by_irrelevant;
+            std::vector<int> not_simulates_irrelevant;
+        };
+
+        // Only reads the relation, so it can be called concurrently for different factors
+        [[nodiscard]] FactorUpdate compute_factor_update(int factor, const fts::LabelledTransitionSystem& lts, const FactorDominanceRelation& sim) const;
+        // Applies the update and, if changed_classes is given, adds the classes whose dominating classes changed
+        bool apply_factor_update(int factor, const fts::LabelledTransitionSystem& lts, const FactorUpdate& update,
+                                 std::vector<int>* changed_classes = nullptr);
+
+    public:
+        LabelClassRelation(const fts::FTSTask& fts_task, utils::LogProxy& log);
+
+        [[nodiscard]] bool label_dominates_label_in_all_other(int factor, const fts::FTSTask& fts_task, int l1, int l2) const override;
+
+        [[nodiscard]] bool noop_dominates_label_in_all_other(int factor, const fts::FTSTask& fts_task, int l) const override;
+
+        bool update_factor(int factor, const fts::FTSTask& fts_task, const FactorDominanceRelation& sim) override;
+
+        std::function<bool()> collect_factor_update(int factor, const fts::FTSTask& fts_task, const FactorDominanceRelation& sim) override;
+
+        LabelRelationChanges update_factor_incremental(int factor, const fts::FTSTask& fts_task, const FactorDominanceRelation& sim,
+                                                       const std::vector<std::pair<int, int>>& removed_simulations) override;
+
+        [[nodiscard]] int get_num_label_classes() const {
+            return representative.size();
+        }
+    };
+}
+
+#endif
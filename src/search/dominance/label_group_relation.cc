@@ -39,14 +39,6 @@ namespace dominance {
     // Noop can always be applied
     noop_simulations = all_labels_groups;
 
-    label_group_state_targets.resize(lts.get_num_label_groups(),
-                                     std::vector<std::vector<int>>(lts.size()));
-    for (const auto tr : lts.get_transitions()) {
-      label_group_state_targets.at(tr.label_group.group)
-                               .at(tr.src)
-                               .push_back(tr.target);
-    }
-
 #ifndef NDEBUG
     // std::println("{} simulations: {}", factor, boost::algorithm::join(std::views::transform(simulations, [&](const auto& p) { return std::format("{} <= {}", lts.label_group_name(p.second), lts.label_group_name(p.first));}) | std::ranges::to<std::vector>(), ", "));
     // std::println("{} simulations_noop: {}", factor, boost::algorithm::join(std::views::transform(simulations_noop, [&](const auto& p) { return std::format("{}", lts.label_group_name(p));}) | std::ranges::to<std::vector>(), ", "));
@@ -70,8 +62,8 @@ namespace dominance {
     return noop_simulations.contains(lg);
   }
 
-  const std::vector<int>& LabelGroupSimulationRelation::targets_for_label_group_state(LabelGroup lg, int s) const {
-    return label_group_state_targets.at(lg.group).at(s);
+  std::span<const int> LabelGroupSimulationRelation::targets_for_label_group_state(LabelGroup lg, int s) const {
+    return lts.get_targets(lg, s);
   }
 
   bool LabelGroupSimulationRelation::compute_simulates(
@@ -1,5 +1,6 @@
 #ifndef DOMINANCE_LABEL_GROUP_RELATION_H
 #define DOMINANCE_LABEL_GROUP_RELATION_H
+#include <span>
 #include <unordered_set>
 #include <vector>
 
@@ -29,9 +30,6 @@ namespace std {
 
 namespace dominance {
 class LabelGroupSimulationRelation {
-  // For lg, state s, the states s' s.t. s -lg-> s'
-  std::vector<std::vector<std::vector<int>>> label_group_state_targets;
-
 public:
   const LabelledTransitionSystem &lts;
   int factor;
@@ -55,7 +53,8 @@ public:
   // Computes whether lg is simulated by noop in all other transition systems
   [[nodiscard]] bool noop_simulates(const LabelGroup lg) const;
 
-  [[nodiscard]] const std::vector<int> &
+  // For lg, state s, the states s' s.t. s -lg-> s'
+  [[nodiscard]] std::span<const int>
   targets_for_label_group_state(LabelGroup lg, int s) const;
 
   [[nodiscard]] bool
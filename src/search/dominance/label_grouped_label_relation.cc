@@ -50,6 +50,13 @@ namespace dominance {
         return label_group_simulation_relations.at(factor).update(sim);
     }
 
+    std::function<bool()> LabelGroupedLabelRelation::collect_factor_update(int factor, const fts::FTSTask& fts_task, const FactorDominanceRelation& sim) {
+        bool changes = update_factor(factor, fts_task, sim);
+        return [changes]() {
+            return changes;
+        };
+    }
+
     void LabelGroupedLabelRelation::print_label_dominance() const {
         for (const auto& lgsr : label_group_simulation_relations) {
             std::println("Factor {}", lgsr.factor);
@@ -43,6 +43,9 @@ namespace dominance {
 
         bool update_factor(int factor, const fts::FTSTask& fts_task, const FactorDominanceRelation& sim) override;
 
+        // The relation of each factor is stored separately, so the update can be done right away
+        std::function<bool()> collect_factor_update(int factor, const fts::FTSTask& fts_task, const FactorDominanceRelation& sim) override;
+
         void print_label_dominance() const;
 
         [[nodiscard]] bool label_group_simulates(int factor, fts::LabelGroup lg1, fts::LabelGroup lg2) const;
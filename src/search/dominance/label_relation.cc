@@ -8,12 +8,54 @@
 #include "../factored_transition_system/label_map.h"
 #include "../plugins/plugin.h"
 
+#include <algorithm>
+#include <numeric>
+
 using namespace std;
 using namespace fts;
 
 namespace dominance {
     LabelRelation::LabelRelation(int num_labels) : num_labels(num_labels) { }
 
+    std::function<bool()> LabelRelation::collect_factor_update(int factor, const fts::FTSTask& fts_task, const FactorDominanceRelation& sim) {
+        return [this, factor, &fts_task, &sim]() {
+            return update_factor(factor, fts_task, sim);
+        };
+    }
+
+    LabelRelationChanges LabelRelation::update_factor_incremental(int factor, const fts::FTSTask& fts_task, const FactorDominanceRelation& sim,
+                                                                  const std::vector<std::pair<int, int>>& /*removed_simulations*/) {
+        LabelRelationChanges changes;
+        if (update_factor(factor, fts_task, sim)) {
+            changes.dominated_labels.resize(num_labels);
+            std::iota(changes.dominated_labels.begin(), changes.dominated_labels.end(), 0);
+        }
+        return changes;
+    }
+
+    bool group_simulates(const fts::LabelledTransitionSystem& lts, fts::LabelGroup lg1, fts::LabelGroup lg2, const FactorDominanceRelation& sim) {
+        return std::ranges::all_of(lts.get_transitions_label_group(lg2), [&](const auto& tr) {
+            return std::ranges::any_of(lts.get_targets(lg1, tr.src), [&](int target_1) {
+                return sim.simulates(target_1, tr.target);
+            });
+        });
+    }
+
+    bool noop_simulates_group(const fts::LabelledTransitionSystem& lts, fts::LabelGroup lg, const FactorDominanceRelation& sim) {
+        return std::ranges::all_of(lts.get_transitions_label_group(lg), [&](const auto& tr) {
+            return sim.simulates(tr.src, tr.target);
+        });
+    }
+
+    bool group_simulates_noop(const fts::LabelledTransitionSystem& lts, fts::LabelGroup lg, const FactorDominanceRelation& sim) {
+        for (int s = 0; s < lts.size(); s++) {
+            if (std::ranges::none_of(lts.get_targets(lg, s), [&](int t) { return sim.simulates(t, s); })) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     void LabelRelation::dump(utils::LogProxy& log, const fts::FTSTask& fts_task ) const {
         for (int i = 0; i < static_cast<int>(fts_task.get_factors().size()); ++i) {
             log << std::format("Factor {}", i) << std::endl;
@@ -1,10 +1,15 @@
 #ifndef DOMINANCE_LABEL_RELATION_H
 #define DOMINANCE_LABEL_RELATION_H
 
+#include <functional>
 #include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace fts {
     class FTSTask;
+    class LabelGroup;
     class LabelledTransitionSystem;
     class LabelMap;
 }
@@ -16,6 +21,25 @@ namespace utils {
 namespace dominance {
     class FactorDominanceRelation;
 
+    // Result of an incremental update of the label relation for one factor
+    struct LabelRelationChanges {
+        // Labels l for which the labels (or noop) that dominate l may have changed
+        std::vector<int> dominated_labels;
+        // Number of label (group) pairs that were checked. Only counted by relations with incremental support.
+        long long checked_pairs = 0;
+
+        bool any() const {
+            return !dominated_labels.empty();
+        }
+    };
+
+    // Checks in the factor whether each s--lg2-->s' has some s--lg1-->t' with s' <= t'
+    [[nodiscard]] bool group_simulates(const fts::LabelledTransitionSystem& lts, fts::LabelGroup lg1, fts::LabelGroup lg2, const FactorDominanceRelation& sim);
+    // Checks in the factor whether each s--lg-->s' has s' <= s
+    [[nodiscard]] bool noop_simulates_group(const fts::LabelledTransitionSystem& lts, fts::LabelGroup lg, const FactorDominanceRelation& sim);
+    // Checks in the factor whether each state s has some s--lg-->t with s <= t
+    [[nodiscard]] bool group_simulates_noop(const fts::LabelledTransitionSystem& lts, fts::LabelGroup lg, const FactorDominanceRelation& sim);
+
     /*
      * Label relation represents the preorder relations on labels that
      * occur in a set of LTS
@@ -34,6 +58,21 @@ namespace dominance {
 
         virtual bool update_factor(int factor, const fts::FTSTask& fts_task, const FactorDominanceRelation& sim) = 0;
 
+        /*
+         * Two-phase version of update_factor used to update several factors concurrently. This method may be called
+         * from several threads at once for different factors. The returned function merges the collected changes
+         * into the relation, is called sequentially and returns whether there were any changes.
+         * By default, the whole update is deferred to the merge phase.
+         */
+        virtual std::function<bool()> collect_factor_update(int factor, const fts::FTSTask& fts_task, const FactorDominanceRelation& sim);
+
+        /*
+         * Incremental version of update_factor: removed_simulations contains the pairs (t, s) such that t no longer
+         * simulates s in the factor since the last update, and only the label pairs that depended on them need to be
+         * checked. The default implementation calls update_factor and, if anything changed, reports all labels.
+         */
+        virtual LabelRelationChanges update_factor_incremental(int factor, const fts::FTSTask& fts_task, const FactorDominanceRelation& sim,
+                                                               const std::vector<std::pair<int, int>>& removed_simulations);
 
         void dump(utils::LogProxy &log, const fts::FTSTask& fts_task) const;
     };
@@ -41,13 +80,18 @@ namespace dominance {
     class LabelRelationFactory {
     public:
         virtual ~LabelRelationFactory() = default;
-        virtual std::unique_ptr<LabelRelation> create(const fts::FTSTask& fts_task) = 0;
+        // log is the log of the dominance analysis that creates the relation
+        virtual std::unique_ptr<LabelRelation> create(const fts::FTSTask& fts_task, utils::LogProxy& log) = 0;
     };
 
     template<class LabelRelationType>
     class LabelRelationFactoryImpl final : public LabelRelationFactory {
-        std::unique_ptr<LabelRelation> create(const fts::FTSTask& fts_task) override {
-            return std::make_unique<LabelRelationType>(fts_task);
+        std::unique_ptr<LabelRelation> create(const fts::FTSTask& fts_task, utils::LogProxy& log) override {
+            if constexpr (std::is_constructible_v<LabelRelationType, const fts::FTSTask&, utils::LogProxy&>) {
+                return std::make_unique<LabelRelationType>(fts_task, log);
+            } else {
+                return std::make_unique<LabelRelationType>(fts_task);
+            }
         }
     };
 }
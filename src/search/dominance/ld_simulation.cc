@@ -7,6 +7,9 @@
 
 #include "../plugins/plugin.h"
 #include "../utils/markup.h"
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
 
 using std::vector;
 
@@ -15,9 +18,20 @@ namespace dominance {
         return compute_ld_simulation(task, log);
     }
 
+    std::unique_ptr<StateDominanceRelation> LDSimulation::restore_dominance_relation(
+            const fts::FTSTask &task, const std::vector<std::vector<std::pair<int, int>>> &simulations) {
+        return restore_ld_simulation(task, *factor_dominance_relation_factory, *label_relation_factory, simulations, log);
+    }
+
     std::unique_ptr<StateDominanceRelation> LDSimulation::compute_ld_simulation(const fts::FTSTask & task, utils::LogProxy & log) {
         utils::Timer t;
 
+        std::unique_ptr<utils::ThreadPool> pool;
+        if (num_threads > 1) {
+            log << "Refining factors with " << num_threads << " threads" << std::endl;
+            pool = std::make_unique<utils::ThreadPool>(num_threads);
+        }
+
         std::vector<std::unique_ptr<FactorDominanceRelation>> local_relations;
         local_relations.reserve(task.get_num_variables());
         for (const auto & lts: task.get_factors()) {
@@ -26,9 +40,9 @@ namespace dominance {
 
         log << "Initialize label dominance: " << task.get_num_labels() << " labels " << task.get_num_variables() << " systems." << std::endl;
 
-        std::unique_ptr<LabelRelation> label_relation = label_relation_factory->create(task);
+        std::unique_ptr<LabelRelation> label_relation = label_relation_factory->create(task, log);
         // Label relation is updated once before first iteration of local relation updates
-        update_label_relation(*label_relation, task, local_relations);
+        update_label_relation(*label_relation, task, local_relations, pool.get());
 
         int total_size = 0, max_size = 0, total_trsize = 0, max_trsize = 0;
         for (const auto & lts: task.get_factors()) {
@@ -46,11 +60,18 @@ namespace dominance {
 
         log << "Init LDSim in " << t() << ":" << std::flush;
         do {
-            for (int i = 0; i < static_cast<int>(local_relations.size()); i++) {
-                update_local_relation(i, task, *label_relation, *(local_relations[i]));
+            if (pool) {
+                // Within one round, the factors only share the (read-only) label relation
+                pool->parallel_for(static_cast<int>(local_relations.size()), [&](int i) {
+                    update_local_relation(i, task, *label_relation, *(local_relations[i]));
+                });
+            } else {
+                for (int i = 0; i < static_cast<int>(local_relations.size()); i++) {
+                    update_local_relation(i, task, *label_relation, *(local_relations[i]));
+                }
             }
             log << " " << t() << std::flush;
-        } while (update_label_relation(*label_relation, task, local_relations));
+        } while (update_label_relation(*label_relation, task, local_relations, pool.get()));
         log << std::endl << "LDSimulation finished: " << t() << std::endl;
 
 #ifndef NDEBUG
@@ -66,64 +87,67 @@ namespace dominance {
 
     bool update_local_relation(int lts_id, const fts::FTSTask& fts_task, const LabelRelation& label_dominance,
                                FactorDominanceRelation& local_relation) {
-        bool changes = true;
-        bool any_changes = false;
-        const fts::LabelledTransitionSystem& lts = fts_task.get_factor(lts_id);
-        while (changes) {
-            changes = local_relation.remove_simulations_if([&](int t, int s) {
-                //log << "Checking states " << lts->name(s) << " and " << lts->name(t) << endl;
-                //Check if really t simulates s
-                //for each transition s--l->s':
-                // a) with noop t >= s' and l dominated by noop?
-                // b) exist t--l'-->t', t' >= s' and l dominated by l'?
-                return lts.applyPostSrc(s, [&](const auto &trs) {
-                    //log << "Checking transition " << s << " to " << trs.target << std::endl;
-
-                    const std::vector<int> &labels_trs = lts.get_labels(trs.label_group);
-                 //   assert(!labels_trs.empty());
-                    for (int labels_tr : labels_trs) {
-                        //log << "Checking label " << labels_trs[i] << " to " << trs.target << std::endl;
-                        if (local_relation.simulates(t, trs.target) && label_dominance.noop_dominates_label_in_all_other(lts_id, fts_task, labels_tr)) {
-                            continue;
-                        }
-                        bool found =
-                                lts.applyPostSrc(t, [&](const auto &trt) {
-                                    if (local_relation.simulates(trt.target, trs.target)) {
-                                        const std::vector<int> &labels_trt = lts.get_labels(trt.label_group);
-                                        for (int label_trt: labels_trt) {
-                                            if (label_dominance.label_dominates_label_in_all_other(lts_id, fts_task, label_trt, labels_tr)) {
-                                                return true;
-                                            }
-                                        }
-                                    }
-                                    return false;
-                                });
-
-                        if (!found) {
-                            return true;
-                        }
-                    }
-
-                    return false;
-                });
+        return local_relation.update(lts_id, fts_task, label_dominance);
+    }
+
+    std::unique_ptr<StateDominanceRelation> restore_ld_simulation(const fts::FTSTask &task,
+                                                                  FactorDominanceRelationFactory &factor_dominance_relation_factory,
+                                                                  LabelRelationFactory &label_relation_factory,
+                                                                  const std::vector<std::vector<std::pair<int, int>>> &simulations,
+                                                                  utils::LogProxy &log) {
+        if (static_cast<int>(simulations.size()) != task.get_num_variables()) {
+            return nullptr;
+        }
+        std::vector<std::unique_ptr<FactorDominanceRelation>> local_relations;
+        local_relations.reserve(task.get_num_variables());
+        for (int factor = 0; factor < task.get_num_variables(); ++factor) {
+            auto relation = factor_dominance_relation_factory.create(task.get_factor(factor));
+            const auto &pairs = simulations[factor];
+            relation->remove_simulations_if([&](int s, int t) {
+                return !std::ranges::binary_search(pairs, std::make_pair(s, t));
+            });
+            // Relations only shrink during the computation, so all stored pairs must be in the initial one
+            size_t num_pairs = 0;
+            relation->apply_to_simulations_until([&](int s, int t) {
+                num_pairs += s != t;
+                return false;
             });
-            any_changes |= changes;
+            if (num_pairs != pairs.size()) {
+                return nullptr;
+            }
+            local_relations.push_back(std::move(relation));
         }
-        return any_changes;
+
+        std::unique_ptr<LabelRelation> label_relation = label_relation_factory.create(task, log);
+        update_label_relation(*label_relation, task, local_relations);
+        return std::make_unique<StateDominanceRelation>(std::move(local_relations), label_relation);
     }
 
-    bool update_label_relation(LabelRelation& label_relation, const fts::FTSTask & task, const std::vector<std::unique_ptr<FactorDominanceRelation>> &sim) {
+    bool update_label_relation(LabelRelation& label_relation, const fts::FTSTask & task, const std::vector<std::unique_ptr<FactorDominanceRelation>> &sim,
+                               utils::ThreadPool* pool) {
         bool changes = false;
-        for (int i = 0; i < task.get_num_variables(); ++i) {
-            changes |= label_relation.update_factor(i, task, *(sim[i]));
+        if (!pool) {
+            for (int i = 0; i < task.get_num_variables(); ++i) {
+                changes |= label_relation.update_factor(i, task, *(sim[i]));
+            }
+            return changes;
+        }
+
+        std::vector<std::function<bool()>> factor_updates(task.get_num_variables());
+        pool->parallel_for(task.get_num_variables(), [&](int i) {
+            factor_updates[i] = label_relation.collect_factor_update(i, task, *(sim[i]));
+        });
+        for (const auto& merge_update : factor_updates) {
+            changes |= merge_update();
         }
         return changes;
     }
 
 
 
-    LDSimulation::LDSimulation(utils::Verbosity verbosity, std::shared_ptr<FactorDominanceRelationFactory> factor_dominance_relation_factory, std::shared_ptr<LabelRelationFactory> label_relation_factory) :
-            log(utils::get_log_for_verbosity(verbosity)), factor_dominance_relation_factory(std::move(factor_dominance_relation_factory)), label_relation_factory(std::move(label_relation_factory)) {
+    LDSimulation::LDSimulation(utils::Verbosity verbosity, std::shared_ptr<FactorDominanceRelationFactory> factor_dominance_relation_factory, std::shared_ptr<LabelRelationFactory> label_relation_factory, int num_threads) :
+            log(utils::get_log_for_verbosity(verbosity)), factor_dominance_relation_factory(std::move(factor_dominance_relation_factory)), label_relation_factory(std::move(label_relation_factory)),
+            num_threads(num_threads) {
     }
 
 
@@ -154,6 +178,11 @@ namespace dominance {
             add_option<std::shared_ptr<LabelRelationFactory>>("lr",
                                                        "The data structure to store the label relation",
                                                        "dense_lr()");
+            add_option<int>("threads",
+                            "Number of threads used to refine the factor relations. In each round, the factors are "
+                            "refined concurrently, and the label relation updates of all factors are merged afterwards.",
+                            "1",
+                            plugins::Bounds("1", "infinity"));
 
             utils::add_log_options_to_feature(*this);
         }
@@ -161,10 +190,13 @@ namespace dominance {
 
         virtual std::shared_ptr<LDSimulation> create_component(const plugins::Options &opts) const override {
 
-            return plugins::make_shared_from_arg_tuples<LDSimulation>(
+            auto analysis = plugins::make_shared_from_arg_tuples<LDSimulation>(
                     utils::get_log_arguments_from_options(opts),
                     opts.get<std::shared_ptr<FactorDominanceRelationFactory>>("fdr"),
-                    opts.get<std::shared_ptr<LabelRelationFactory>>("lr"));
+                    opts.get<std::shared_ptr<LabelRelationFactory>>("lr"),
+                    opts.get<int>("threads"));
+            analysis->set_config(opts.get_unparsed_config());
+            return analysis;
         }
     };
 
@@ -11,6 +11,10 @@ namespace fts {
     class LabelledTransitionSystem;
 }
 
+namespace utils {
+    class ThreadPool;
+}
+
 namespace dominance {
     class FactorDominanceRelationFactory;
     class FactorDominanceRelation;
@@ -19,19 +23,36 @@ namespace dominance {
 
     bool update_local_relation(int lts_id, const fts::FTSTask& task, const LabelRelation& label_dominance,
                                FactorDominanceRelation& local_relation);
-    bool update_label_relation(LabelRelation& label_relation, const fts::FTSTask & task, const std::vector<std::unique_ptr<FactorDominanceRelation>> &sim);
+    // If a thread pool is given, the factors are checked concurrently and the changes merged afterwards
+    bool update_label_relation(LabelRelation& label_relation, const fts::FTSTask & task, const std::vector<std::unique_ptr<FactorDominanceRelation>> &sim,
+                               utils::ThreadPool* pool = nullptr);
+
+    /*
+     * Rebuilds a relation computed with the given factories from its sorted simulation pairs (s, t), s != t, in each
+     * factor. As the label relation is determined by the factor relations at the fixpoint, it is recomputed with a
+     * single update. Returns nullptr if some pair is not in the initial relation of its factor.
+     */
+    std::unique_ptr<StateDominanceRelation> restore_ld_simulation(const fts::FTSTask &task,
+                                                                  FactorDominanceRelationFactory &factor_dominance_relation_factory,
+                                                                  LabelRelationFactory &label_relation_factory,
+                                                                  const std::vector<std::vector<std::pair<int, int>>> &simulations,
+                                                                  utils::LogProxy &log);
 
     class LDSimulation : public DominanceAnalysis {
         utils::LogProxy log;
         std::shared_ptr<FactorDominanceRelationFactory> factor_dominance_relation_factory;
         std::shared_ptr<LabelRelationFactory> label_relation_factory;
+        // Number of threads used to refine the factors concurrently. With 1, everything is done sequentially.
+        int num_threads;
 
         std::unique_ptr<StateDominanceRelation> compute_ld_simulation(const fts::FTSTask & task, utils::LogProxy & log);
     public:
-        explicit LDSimulation(utils::Verbosity verbosity, std::shared_ptr<FactorDominanceRelationFactory> factor_dominance_relation_factory, std::shared_ptr<LabelRelationFactory> label_relation_factory);
+        explicit LDSimulation(utils::Verbosity verbosity, std::shared_ptr<FactorDominanceRelationFactory> factor_dominance_relation_factory, std::shared_ptr<LabelRelationFactory> label_relation_factory, int num_threads);
 
         virtual ~LDSimulation() = default;
         std::unique_ptr<StateDominanceRelation> compute_dominance_relation(const fts::FTSTask &task) override;
+        std::unique_ptr<StateDominanceRelation> restore_dominance_relation(
+                const fts::FTSTask &task, const std::vector<std::vector<std::pair<int, int>>> &simulations) override;
     };
 }
 
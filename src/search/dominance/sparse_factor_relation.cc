@@ -31,6 +31,10 @@ namespace dominance {
         return s == t || simulations.contains({t, s});
     }
 
+    void SparseFactorRelation::remove(int t, int s) {
+        simulations.erase({t, s});
+    }
+
     bool SparseFactorRelation::similar(int s, int t) const {
         return simulates(s, t) && simulates(t, s);
     }
@@ -33,6 +33,8 @@ public:
 
   [[nodiscard]] bool similar(int s, int t) const override;
 
+  void remove(int t, int s) override;
+
   int num_simulations() const override;
   bool apply_to_simulations_until(std::function<bool(int s, int t)>&& f) const override;
   bool remove_simulations_if(std::function<bool(int s, int t)>&& f) override;
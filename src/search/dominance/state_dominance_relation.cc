@@ -42,6 +42,15 @@ namespace dominance {
         return true;
     }
 
+    bool StateDominanceRelation::dominates(const std::vector<int>& t, const std::vector<int>& s) const {
+        for (size_t i = 0; i < local_relations.size(); ++i) {
+            if (!local_relations[i]->simulates(t[i], s[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     double StateDominanceRelation::get_percentage_equivalences() const {
         double percentage = 1;
         for (auto &sim: local_relations) {
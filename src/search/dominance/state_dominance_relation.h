@@ -70,6 +70,8 @@ namespace dominance {
 
         //Methods to use the simulation
         [[nodiscard]] bool dominates(const State &t, const State &s) const;
+        // Same as above, for states that are already transformed to the factors of the relation
+        [[nodiscard]] bool dominates(const std::vector<int> &t, const std::vector<int> &s) const;
 
     // TODO (future): Integrate methods for task transformation from the fd_simulation repository
 
@@ -3,34 +3,21 @@
 #include "../dominance/state_dominance_relation.h"
 #include "../plugins/plugin.h"
 
+#include <algorithm>
+
 namespace dominance {
     void DatabaseAllPrevious::insert(const std::vector<int>& transformed_state, int) {
         // previous_states.push_back(state);
-        previous_transformed_states.push_back(transformed_state);
+        previous_transformed_states.insert(previous_transformed_states.end(), transformed_state.begin(), transformed_state.end());
     }
 
     bool DatabaseAllPrevious::check(const ExplicitState &succ_transformed, int) const {
         // Loop over all previously generated states and check if any dominate the current state
-        for (size_t i = 0; i < previous_transformed_states.size(); ++i) {
-
-            // const ExplicitState &prev_state = previous_states[i];
-            const ExplicitState &prev_transformed = previous_transformed_states[i];
-
-            bool dominates = true;
-            // Iterate  over each factor of the transformed states. If some factor does not dominate, then the previous state does not dominate the current state
-            for (size_t factor = 0; factor < prev_transformed.size(); ++factor) {
-                // Check if the previous state dominates the current state for this factor
-                if (!(*dominance_relation)[factor].simulates(prev_transformed[factor], succ_transformed[factor])) {
-                    dominates = false;
-                    break;
-                }
-            }
-
-            if (dominates) {
-                return true;  // Prune if dominated by any previous state
-            }
-        }
-        return false;
+        return dominance_relation->any_dominates(previous_transformed_states, succ_transformed);
+    }
+
+    long DatabaseAllPrevious::get_size() const {
+        return previous_transformed_states.size() / std::max(1, dominance_relation->get_num_factors());
     }
 
 
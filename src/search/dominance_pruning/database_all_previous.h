@@ -2,16 +2,18 @@
 #define DOMINANCE_DATABASE_ALL_PREVIOUS_H
 
 #include "dominance_database.h"
+#include "../dominance/frozen_dominance_relation.h"
 
 namespace dominance {
 class DatabaseAllPrevious : public DominanceDatabase {
-    std::vector<ExplicitState> previous_transformed_states;
+    // Transformed states stored one after another
+    std::vector<int> previous_transformed_states;
 
-    std::shared_ptr<StateDominanceRelation> dominance_relation;
+    std::shared_ptr<const FrozenDominanceRelation> dominance_relation;
     //std::shared_ptr<fts::FactoredStateMapping> state_mapping;
 
 public:
-    DatabaseAllPrevious(std::shared_ptr<StateDominanceRelation> dominance_relation)
+    DatabaseAllPrevious(std::shared_ptr<const FrozenDominanceRelation> dominance_relation)
         : dominance_relation(dominance_relation){//, state_mapping(state_mapping) {
     }
     virtual ~DatabaseAllPrevious() = default;
@@ -22,6 +24,8 @@ public:
     //Insert: inserts a state into the set of known states
     void insert(const ExplicitState &transformed_state, int g) override;
 
+    long get_size() const override;
+
 
 };
 
@@ -31,10 +35,11 @@ public:
         }
 
         virtual std::unique_ptr<DominanceDatabase> create(const std::shared_ptr<AbstractTask> &,
-                                                          std::shared_ptr<StateDominanceRelation> dominance_relation,
+                                                          std::shared_ptr<StateDominanceRelation>,
+                                                          std::shared_ptr<const FrozenDominanceRelation> frozen_relation,
                                                           std::shared_ptr<fts::FactoredStateMapping> ) override
         {
-            return std::make_unique<DatabaseAllPrevious>(dominance_relation);
+            return std::make_unique<DatabaseAllPrevious>(frozen_relation);
         }
     };
 
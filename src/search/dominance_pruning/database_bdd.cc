@@ -25,9 +25,11 @@ namespace dominance {
 
     std::unique_ptr<DominanceDatabase> DatabaseBDDFactory::create(const std::shared_ptr<AbstractTask> & task,
                                                                      std::shared_ptr<StateDominanceRelation> dominance_relation,
+                                                                     std::shared_ptr<const FrozenDominanceRelation>,
                                                                       std::shared_ptr<fts::FactoredStateMapping> state_mapping) {
 
-        auto vars = std::make_shared<SymVariables>(bdd_mgr, *variable_ordering_strategy, task);
+        auto vars = std::make_shared<SymVariables>(bdd_mgr, *variable_ordering_strategy, task,
+                                                   state_mapping->get_variable_partitions(task->get_num_variables()));
         fts::FactoredSymbolicStateMapping sym_mapping (*state_mapping, vars);
 
       auto dominance_bdd = std::make_shared<DominanceRelationBDD>(*dominance_relation, sym_mapping, insert_dominated);
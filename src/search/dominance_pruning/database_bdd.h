@@ -63,6 +63,7 @@ namespace dominance {
 
         virtual std::unique_ptr<DominanceDatabase> create(const std::shared_ptr<AbstractTask> &task,
                                                           std::shared_ptr<StateDominanceRelation> dominance_relation,
+                                                          std::shared_ptr<const FrozenDominanceRelation> frozen_relation,
                                                           std::shared_ptr<fts::FactoredStateMapping> state_mapping) override;
     };
 }
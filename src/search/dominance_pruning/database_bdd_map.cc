@@ -6,20 +6,24 @@
 #include "../symbolic/sym_variables.h"
 #include "../factored_transition_system/symbolic_state_mapping.h"
 #include "../variable_ordering/variable_ordering_strategy.h"
+
+#include <algorithm>
 using namespace symbolic;
 namespace dominance {
 
 
     std::unique_ptr<DominanceDatabase> DatabaseBDDMapFactory::create(const std::shared_ptr<AbstractTask> & task,
                                                                      std::shared_ptr<StateDominanceRelation> dominance_relation,
+                                                                     std::shared_ptr<const FrozenDominanceRelation>,
                                                                       std::shared_ptr<fts::FactoredStateMapping> state_mapping) {
 
-        auto vars = std::make_shared<SymVariables>(bdd_mgr, *variable_ordering_strategy, task);
+        auto vars = std::make_shared<SymVariables>(bdd_mgr, *variable_ordering_strategy, task,
+                                                   state_mapping->get_variable_partitions(task->get_num_variables()));
         fts::FactoredSymbolicStateMapping sym_mapping (*state_mapping, vars);
 
       auto dominance_bdd = std::make_shared<DominanceRelationBDD>(*dominance_relation, sym_mapping, insert_dominated);
       if (insert_dominated) {
-          return std::make_unique<DatabaseBDDMapDominated>(vars, dominance_bdd);
+          return std::make_unique<DatabaseBDDMapDominated>(vars, dominance_bdd, skip_single_states);
       } else {
           return std::make_unique<DatabaseBDDMapDominating>(vars, dominance_bdd);
         }
@@ -39,7 +43,7 @@ namespace dominance {
                         }
                     }
         */
-        if (vars->numStates(res) == 1) {
+        if (skip_single_states && vars->numStates(res) == 1) {
             //Small optimization: If we have a single state, not include it
             res = vars->zeroBDD();
         }
@@ -49,6 +53,7 @@ namespace dominance {
         } else {
             closed[g] += res;
         }
+        vars->get_bdd_manager()->reorder_if_needed();
     }
 
     bool DatabaseBDDMapDominated::check(const ExplicitState &state, int g) const {
@@ -70,6 +75,7 @@ namespace dominance {
         } else {
             closed[g] += res;
         }
+        vars->get_bdd_manager()->reorder_if_needed();
     }
 
     bool DatabaseBDDMapDominating::check(const ExplicitState &state, int g) const {
@@ -85,6 +91,124 @@ namespace dominance {
     }
 
 
+    void DatabaseBDDMapDominated::check_batch(const std::vector<ExplicitState> &states, const std::vector<int> &g_values,
+                                              std::vector<bool> &dominated) const {
+        dominated.assign(states.size(), false);
+        if (closed.empty() || states.empty()) {
+            return;
+        }
+
+        // All states of the batch in a single BDD, so that the g layers that contain none of them are skipped
+        BDD batch = vars->zeroBDD();
+        for (const ExplicitState &state : states) {
+            batch += vars->getStateBDD(state);
+        }
+        const int max_g = *std::ranges::max_element(g_values);
+
+        for (auto &entry: closed) {
+            if (entry.first > max_g) break;
+            if (entry.second.Intersect(batch).IsZero()) {
+                continue;
+            }
+            for (size_t i = 0; i < states.size(); ++i) {
+                if (!dominated[i] && entry.first <= g_values[i] &&
+                    !(entry.second.Eval(vars->getBinaryDescription(states[i])).IsZero())) {
+                    dominated[i] = true;
+                }
+            }
+        }
+    }
+
+    void DatabaseBDDMapDominated::insert_batch(const std::vector<ExplicitState> &states, const std::vector<int> &g_values) {
+        // The states with the same g are joined first, so that the (large) closed BDDs are only updated once per g
+        std::map<int, BDD> batch;
+        for (size_t i = 0; i < states.size(); ++i) {
+            BDD res = dominance_relation_bdd->get_related_states(states[i]);
+            if (skip_single_states && vars->numStates(res) == 1) {
+                continue;
+            }
+            auto [it, inserted] = batch.try_emplace(g_values[i], res);
+            if (!inserted) {
+                it->second += res;
+            }
+        }
+        for (auto &[g, res] : batch) {
+            if (!closed.count(g)) {
+                closed[g] = res;
+            } else {
+                closed[g] += res;
+            }
+        }
+        vars->get_bdd_manager()->reorder_if_needed();
+    }
+
+    long DatabaseBDDMapDominated::get_size() const {
+        long size = 0;
+        for (const auto &[g, bdd] : closed) {
+            size += bdd.nodeCount();
+        }
+        return size;
+    }
+
+    void DatabaseBDDMapDominating::check_batch(const std::vector<ExplicitState> &states, const std::vector<int> &g_values,
+                                               std::vector<bool> &dominated) const {
+        dominated.assign(states.size(), false);
+        if (closed.empty() || states.empty()) {
+            return;
+        }
+
+        std::vector<BDD> simulating;
+        simulating.reserve(states.size());
+        BDD batch = vars->zeroBDD();
+        for (const ExplicitState &state : states) {
+            simulating.push_back(dominance_relation_bdd->get_related_states(state));
+            batch += simulating.back();
+        }
+        const int max_g = *std::ranges::max_element(g_values);
+
+        for (auto &entry: closed) {
+            if (entry.first > max_g) break;
+            // Stored states that dominate some state of the batch; usually much smaller than the layer
+            BDD candidates = entry.second * batch;
+            if (candidates.IsZero()) {
+                continue;
+            }
+            for (size_t i = 0; i < states.size(); ++i) {
+                if (!dominated[i] && entry.first <= g_values[i] && !(candidates.Intersect(simulating[i]).IsZero())) {
+                    dominated[i] = true;
+                }
+            }
+        }
+    }
+
+    void DatabaseBDDMapDominating::insert_batch(const std::vector<ExplicitState> &states, const std::vector<int> &g_values) {
+        std::map<int, BDD> batch;
+        for (size_t i = 0; i < states.size(); ++i) {
+            BDD res = vars->getStateBDD(states[i]);
+            auto [it, inserted] = batch.try_emplace(g_values[i], res);
+            if (!inserted) {
+                it->second += res;
+            }
+        }
+        for (auto &[g, res] : batch) {
+            if (!closed.count(g)) {
+                closed[g] = res;
+            } else {
+                closed[g] += res;
+            }
+        }
+        vars->get_bdd_manager()->reorder_if_needed();
+    }
+
+    long DatabaseBDDMapDominating::get_size() const {
+        long size = 0;
+        for (const auto &[g, bdd] : closed) {
+            size += bdd.nodeCount();
+        }
+        return size;
+    }
+
+
     class DominanceDatabaseBDDMapFeature
         : public plugins::TypedFeature<DominanceDatabaseFactory, DatabaseBDDMapFactory> {
     public:
@@ -102,6 +226,12 @@ namespace dominance {
 
             BDDManager::add_options_to_feature(*this);
             add_option<bool>("insert_dominated", "Insert dominated or check dominating states", "true");
+            add_option<bool>("skip_single_states",
+                             "With insert_dominated, do not store states that only dominate themselves. This saves "
+                             "BDD operations, but such states are not pruned as duplicates when they are generated "
+                             "again, so the results differ from the explicit-state databases. Disable it to compare "
+                             "against them with test().",
+                             "true");
         }
 
         virtual std::shared_ptr<DatabaseBDDMapFactory> create_component(const plugins::Options &opts) const override {
@@ -111,6 +241,7 @@ namespace dominance {
 
             return plugins::make_shared_from_arg_tuples<DatabaseBDDMapFactory>(
                 opts.get<bool>("insert_dominated"),
+                opts.get<bool>("skip_single_states"),
 //                opts.get<bool>("remove_spurious_dominated_states"),
                 bdd_mgr,
                 opts.get < std::shared_ptr < variable_ordering::VariableOrderingStrategy>> ("variable_ordering"));
@@ -20,12 +20,18 @@ namespace dominance {
         std::shared_ptr<DominanceRelationBDD> dominance_relation_bdd;
 
         std::map<int, BDD> closed;
+        /*
+         * Do not store a state whose set of dominated states contains only itself. Such a state is then not
+         * detected as a duplicate when it is generated again, unlike in the explicit-state databases.
+         */
+        const bool skip_single_states;
 
     public:
         DatabaseBDDMapDominated(std::shared_ptr<symbolic::SymVariables> vars,
-                                std::shared_ptr<DominanceRelationBDD> dominance_relation_bdd) : DominanceDatabase(),
+                                std::shared_ptr<DominanceRelationBDD> dominance_relation_bdd,
+                                bool skip_single_states) : DominanceDatabase(),
             vars(vars),
-            dominance_relation_bdd(dominance_relation_bdd) {
+            dominance_relation_bdd(dominance_relation_bdd), skip_single_states(skip_single_states) {
         }
 
         virtual ~DatabaseBDDMapDominated() = default;
@@ -33,6 +39,14 @@ namespace dominance {
         virtual bool check(const ExplicitState &state, int g) const override;
 
         virtual void insert(const ExplicitState &state, int g) override;
+
+        virtual void check_batch(const std::vector<ExplicitState> &states, const std::vector<int> &g_values,
+                                 std::vector<bool> &dominated) const override;
+
+        virtual void insert_batch(const std::vector<ExplicitState> &states, const std::vector<int> &g_values) override;
+
+        // Sum of the nodes of the BDDs of each g value
+        virtual long get_size() const override;
     };
 
     class DatabaseBDDMapDominating : public DominanceDatabase {
@@ -52,24 +66,36 @@ namespace dominance {
         virtual bool check(const ExplicitState &state, int g) const override;
 
         virtual void insert(const ExplicitState &state, int g) override;
+
+        virtual void check_batch(const std::vector<ExplicitState> &states, const std::vector<int> &g_values,
+                                 std::vector<bool> &dominated) const override;
+
+        virtual void insert_batch(const std::vector<ExplicitState> &states, const std::vector<int> &g_values) override;
+
+        // Sum of the nodes of the BDDs of each g value
+        virtual long get_size() const override;
     };
 
 
     class DatabaseBDDMapFactory : public DominanceDatabaseFactory {
         const bool insert_dominated;
+        const bool skip_single_states;
         std::shared_ptr<symbolic::BDDManager> bdd_mgr;
         std::shared_ptr<variable_ordering::VariableOrderingStrategy> variable_ordering_strategy;
 
     public:
-        DatabaseBDDMapFactory(bool insert_dominated, std::shared_ptr<symbolic::BDDManager> bdd_mgr,
+        DatabaseBDDMapFactory(bool insert_dominated, bool skip_single_states,
+                              std::shared_ptr<symbolic::BDDManager> bdd_mgr,
                               std::shared_ptr<variable_ordering::VariableOrderingStrategy>
                               variable_ordering_strategy) : insert_dominated(insert_dominated),
+                                                            skip_single_states(skip_single_states),
                                                             bdd_mgr(bdd_mgr),
                                                             variable_ordering_strategy(variable_ordering_strategy) {
         }
 
         virtual std::unique_ptr<DominanceDatabase> create(const std::shared_ptr<AbstractTask> &task,
                                                           std::shared_ptr<StateDominanceRelation> dominance_relation,
+                                                          std::shared_ptr<const FrozenDominanceRelation> frozen_relation,
                                                           std::shared_ptr<fts::FactoredStateMapping> state_mapping) override;
     };
 }
@@ -0,0 +1,107 @@
+#include "database_indexed.h"
+
+#include "../dominance/factor_dominance_relation.h"
+#include "../dominance/state_dominance_relation.h"
+#include "../plugins/plugin.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace dominance {
+    DatabaseIndexed::DatabaseIndexed(std::shared_ptr<StateDominanceRelation> dominance_relation)
+        : dominance_relation(dominance_relation), num_words(0) {
+        const int num_factors = dominance_relation->size();
+        simulated_values.resize(num_factors);
+        simulating_states.resize(num_factors);
+        for (int factor = 0; factor < num_factors; ++factor) {
+            const FactorDominanceRelation &relation = (*dominance_relation)[factor];
+            simulated_values[factor].resize(relation.get_num_states());
+            simulating_states[factor].resize(relation.get_num_states());
+            relation.apply_to_simulations_until([&](int s, int t) {
+                simulated_values[factor][s].push_back(t);
+                return false;
+            });
+        }
+    }
+
+    void DatabaseIndexed::insert(const ExplicitState &transformed_state, int g) {
+        const int id = g_values.size();
+        g_values.push_back(g);
+        if (id / BITS_PER_WORD >= num_words) {
+            ++num_words;
+            intersection.push_back(0);
+            for (auto &factor_bitsets : simulating_states) {
+                for (auto &bitset : factor_bitsets) {
+                    bitset.push_back(0);
+                }
+            }
+        }
+
+        const Word bit = Word(1) << (id % BITS_PER_WORD);
+        for (size_t factor = 0; factor < simulating_states.size(); ++factor) {
+            for (int t : simulated_values[factor][transformed_state[factor]]) {
+                simulating_states[factor][t][id / BITS_PER_WORD] |= bit;
+            }
+        }
+    }
+
+    bool DatabaseIndexed::check(const ExplicitState &state, int g) const {
+        if (simulating_states.empty()) {
+            return std::ranges::any_of(g_values, [g](int stored_g) { return stored_g <= g; });
+        }
+
+        // The bitsets of the first two factors are intersected in a single pass over all words
+        const std::vector<Word> &first = simulating_states[0][state[0]];
+        const std::vector<Word> &second = simulating_states.size() > 1 ? simulating_states[1][state[1]] : first;
+        non_zero_words.clear();
+        for (int w = 0; w < num_words; ++w) {
+            const Word word = first[w] & second[w];
+            if (word) {
+                intersection[w] = word;
+                non_zero_words.push_back(w);
+            }
+        }
+
+        for (size_t factor = 2; factor < simulating_states.size() && !non_zero_words.empty(); ++factor) {
+            const std::vector<Word> &bitset = simulating_states[factor][state[factor]];
+            size_t num_non_zero = 0;
+            for (int w : non_zero_words) {
+                intersection[w] &= bitset[w];
+                if (intersection[w]) {
+                    non_zero_words[num_non_zero++] = w;
+                }
+            }
+            non_zero_words.resize(num_non_zero);
+        }
+
+        // The remaining states dominate the state; one of them must have been reached with lower or equal g
+        for (int w : non_zero_words) {
+            for (Word word = intersection[w]; word; word &= word - 1) {
+                if (g_values[w * BITS_PER_WORD + std::countr_zero(word)] <= g) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    class DatabaseIndexedFactoryFeature
+        : public plugins::TypedFeature<DominanceDatabaseFactory, DatabaseIndexedFactory> {
+    public:
+        DatabaseIndexedFactoryFeature() : TypedFeature("indexed") {
+            document_title("Indexed Explicit-State Database");
+
+            document_synopsis(
+                "Stores the previous states in an inverted index with one bitset over the stored states for each "
+                "value of each factor, containing the states whose value simulates it. A new state is checked by "
+                "intersecting the bitsets of its values, instead of comparing it with each previous state. Only "
+                "previous states with lower or equal g value are considered.");
+        }
+
+        virtual std::shared_ptr<DatabaseIndexedFactory> create_component(const plugins::Options &) const override {
+            return std::make_shared<DatabaseIndexedFactory>();
+        }
+    };
+
+    static plugins::FeaturePlugin<DatabaseIndexedFactoryFeature> _plugin;
+}
@@ -0,0 +1,64 @@
+#ifndef DOMINANCE_DATABASE_INDEXED_H
+#define DOMINANCE_DATABASE_INDEXED_H
+
+#include <cstdint>
+
+#include "dominance_database.h"
+
+namespace dominance {
+    /*
+     * Stores the states with an inverted index per factor: for each factor and value v, a bitset over the ids of the
+     * stored states whose value in the factor simulates v. A state is dominated by a stored state if the intersection
+     * of the bitsets of its values in every factor contains a state with lower or equal g value. The intersection is
+     * computed one factor at a time, only on the words that are still non-zero, and stops as soon as it is empty.
+     */
+    class DatabaseIndexed : public DominanceDatabase {
+        using Word = uint64_t;
+        static constexpr int BITS_PER_WORD = 64;
+
+        std::shared_ptr<StateDominanceRelation> dominance_relation;
+
+        // simulated_values[factor][s]: values t of the factor such that s simulates t
+        std::vector<std::vector<std::vector<int>>> simulated_values;
+        // simulating_states[factor][v]: bitset of the stored states whose value in factor simulates v
+        std::vector<std::vector<std::vector<Word>>> simulating_states;
+        std::vector<int> g_values;
+        int num_words;
+
+        /*
+         * Words of the intersection and indices of its non-zero words, reused across checks. intersection always
+         * has num_words words, but only the entries listed in non_zero_words are meaningful.
+         */
+        mutable std::vector<Word> intersection;
+        mutable std::vector<int> non_zero_words;
+
+    public:
+        explicit DatabaseIndexed(std::shared_ptr<StateDominanceRelation> dominance_relation);
+        virtual ~DatabaseIndexed() = default;
+
+        //Check: returns true if a better or equal state is known
+        bool check(const ExplicitState &state, int g) const override;
+        //Insert: inserts a state into the set of known states
+        void insert(const ExplicitState &transformed_state, int g) override;
+
+        long get_size() const override {
+            return g_values.size();
+        }
+    };
+
+    class DatabaseIndexedFactory : public DominanceDatabaseFactory {
+    public:
+        DatabaseIndexedFactory() : DominanceDatabaseFactory() {
+        }
+
+        virtual std::unique_ptr<DominanceDatabase> create(const std::shared_ptr<AbstractTask> &,
+                                                          std::shared_ptr<StateDominanceRelation> dominance_relation,
+                                                          std::shared_ptr<const FrozenDominanceRelation>,
+                                                          std::shared_ptr<fts::FactoredStateMapping> ) override
+        {
+            return std::make_unique<DatabaseIndexed>(dominance_relation);
+        }
+    };
+}
+
+#endif
@@ -3,10 +3,14 @@
 #include "../plugins/plugin.h"
 
 #include "../dominance/state_dominance_relation.h"
+
+#include <algorithm>
+
 namespace dominance {
 
     void DatabasePreviousLowerG::insert(const ExplicitState &transformed_state, int g_value) {
-        previous_states_sorted[g_value].emplace_back(transformed_state);
+        auto &states = previous_states_sorted[g_value];
+        states.insert(states.end(), transformed_state.begin(), transformed_state.end());
     }
 
     bool DatabasePreviousLowerG::check(const ExplicitState &succ_transformed, int g_value) const {
@@ -18,23 +22,20 @@ namespace dominance {
             }
 
             // Compare the current state against all states with the same or lower g values
-            for (const ExplicitState &stored_transformed : transformed_states) {
-                bool dominates = true;
-                for (size_t factor = 0; factor < stored_transformed.size(); ++factor) {
-                    if (!(*dominance_relation)[factor].simulates(stored_transformed[factor], succ_transformed[factor])) {
-                        dominates = false;
-                        break;
-                    }
-                }
-
-                if (dominates) {
-                    return true;  // Prune if dominated by any previous state
-                }
+            if (dominance_relation->any_dominates(transformed_states, succ_transformed)) {
+                return true;  // Prune if dominated by any previous state
             }
         }
         return false;
     }
 
+    long DatabasePreviousLowerG::get_size() const {
+        long num_values = 0;
+        for (const auto &[g_value, transformed_states] : previous_states_sorted) {
+            num_values += transformed_states.size();
+        }
+        return num_values / std::max(1, dominance_relation->get_num_factors());
+    }
 
 
     class DatabasePreviousLowerGFactoryFeature
@@ -5,18 +5,19 @@
 
 
 #include "dominance_database.h"
+#include "../dominance/frozen_dominance_relation.h"
 
 namespace dominance {
 
     class DatabasePreviousLowerG : public DominanceDatabase {
-        // key: g_value; value: vector<vector<int>> with the transformed states with that g_value
-        std::map<int, std::vector<std::vector<int>>> previous_states_sorted;
+        // key: g_value; value: the transformed states with that g_value, stored one after another
+        std::map<int, std::vector<int>> previous_states_sorted;
 
-        std::shared_ptr<StateDominanceRelation> dominance_relation;
+        std::shared_ptr<const FrozenDominanceRelation> dominance_relation;
         //std::shared_ptr<fts::FactoredStateMapping> state_mapping;
 
     public:
-        DatabasePreviousLowerG(std::shared_ptr<StateDominanceRelation> dominance_relation)
+        DatabasePreviousLowerG(std::shared_ptr<const FrozenDominanceRelation> dominance_relation)
                                 //  std::shared_ptr<fts::FactoredStateMapping> state_mapping)
           : dominance_relation(dominance_relation) {//, state_mapping(state_mapping) {
         }
@@ -27,6 +28,8 @@ namespace dominance {
         bool check(const ExplicitState &succ_transformed, int g_value) const override;
         //Insert: inserts a state into the set of known states
         void insert(const ExplicitState &transformed_state, int g_value) override;
+
+        long get_size() const override;
     };
 
 
@@ -36,10 +39,11 @@ namespace dominance {
         }
 
         virtual std::unique_ptr<DominanceDatabase> create(const std::shared_ptr<AbstractTask> &,
-                                                          std::shared_ptr<StateDominanceRelation> dominance_relation,
+                                                          std::shared_ptr<StateDominanceRelation>,
+                                                          std::shared_ptr<const FrozenDominanceRelation> frozen_relation,
                                                           std::shared_ptr<fts::FactoredStateMapping> ) override
         {
-          return std::make_unique<DatabasePreviousLowerG>(dominance_relation);
+          return std::make_unique<DatabasePreviousLowerG>(frozen_relation);
           }
     };
 
@@ -0,0 +1,107 @@
+#include "database_statistics.h"
+
+#include "../utils/timer.h"
+
+#include <algorithm>
+#include <bit>
+
+using namespace std;
+
+namespace dominance {
+    void LatencyHistogram::add(chrono::nanoseconds latency) {
+        const long ns = max<long>(latency.count(), 0);
+        const int bucket = min<int>(bit_width(static_cast<unsigned long>(ns)), NUM_BUCKETS - 1);
+        ++buckets[bucket];
+        ++count;
+        total_ns += ns;
+        max_ns = max(max_ns, ns);
+    }
+
+    void LatencyHistogram::dump_json(ostream &os) const {
+        os << "{\"count\": " << count
+           << ", \"mean_ns\": " << (count ? total_ns / count : 0)
+           << ", \"max_ns\": " << max_ns
+           << ", \"log2_buckets\": [";
+        // Bucket i contains the latencies in [2^(i-1), 2^i) ns; trailing empty buckets are omitted
+        int last = NUM_BUCKETS;
+        while (last > 0 && buckets[last - 1] == 0) {
+            --last;
+        }
+        for (int i = 0; i < last; ++i) {
+            os << (i ? ", " : "") << buckets[i];
+        }
+        os << "]}";
+    }
+
+    DatabaseStatistics::DatabaseStatistics(const string &filename, int interval)
+        : interval(interval), output(filename) {
+    }
+
+    void DatabaseStatistics::record_check(Clock::duration latency, const vector<int> &g_values,
+                                          const vector<bool> &dominated) {
+        check_latency.add(chrono::duration_cast<chrono::nanoseconds>(latency));
+        for (size_t i = 0; i < g_values.size(); ++i) {
+            const int g = g_values[i];
+            if (g >= static_cast<int>(checked_per_g.size())) {
+                checked_per_g.resize(g + 1, 0);
+                dominated_per_g.resize(g + 1, 0);
+            }
+            ++checked_per_g[g];
+            ++num_checked;
+            if (dominated[i]) {
+                ++dominated_per_g[g];
+                ++num_dominated;
+            }
+        }
+    }
+
+    void DatabaseStatistics::record_insert(Clock::duration latency, size_t num_states) {
+        insert_latency.add(chrono::duration_cast<chrono::nanoseconds>(latency));
+        num_inserted += num_states;
+    }
+
+    bool DatabaseStatistics::record_expansion() {
+        return ++num_expansions % interval == 0;
+    }
+
+    void DatabaseStatistics::finish(long database_size) {
+        if (finished) {
+            return;
+        }
+        finished = true;
+        if (num_expansions % interval != 0) {
+            write_snapshot(database_size);
+        }
+        output.flush();
+    }
+
+    void DatabaseStatistics::write_snapshot(long database_size) {
+        output << "{\"expansions\": " << num_expansions
+               << ", \"time\": " << static_cast<double>(utils::g_timer())
+               << ", \"checked\": " << num_checked
+               << ", \"dominated\": " << num_dominated
+               << ", \"hit_rate\": " << (num_checked ? static_cast<double>(num_dominated) / num_checked : 0.0)
+               << ", \"inserted\": " << num_inserted;
+        // Databases that do not track their size report -1
+        if (database_size >= 0) {
+            output << ", \"size\": " << database_size
+                   << ", \"size_growth\": " << database_size - last_size;
+            last_size = database_size;
+        }
+        output << ", \"check_latency\": ";
+        check_latency.dump_json(output);
+        output << ", \"insert_latency\": ";
+        insert_latency.dump_json(output);
+        output << ", \"g_layers\": [";
+        bool first = true;
+        for (size_t g = 0; g < checked_per_g.size(); ++g) {
+            if (checked_per_g[g] == 0) {
+                continue;
+            }
+            output << (first ? "" : ", ") << "{\"g\": " << g << ", \"checked\": " << checked_per_g[g]
+                   << ", \"dominated\": " << dominated_per_g[g] << "}";
+            first = false;
+        }
+        output << "]}\n";
+    }
+}
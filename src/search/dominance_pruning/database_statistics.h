@@ -0,0 +1,79 @@
+#ifndef DOMINANCE_DATABASE_STATISTICS_H
+#define DOMINANCE_DATABASE_STATISTICS_H
+
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace dominance {
+    /*
+     * Histogram of latencies with one bucket per power of two nanoseconds, so that recording a sample only costs a
+     * few instructions.
+     */
+    class LatencyHistogram {
+        static constexpr int NUM_BUCKETS = 40;
+        std::array<long, NUM_BUCKETS> buckets{};
+        long count = 0;
+        long total_ns = 0;
+        long max_ns = 0;
+    public:
+        void add(std::chrono::nanoseconds latency);
+        void dump_json(std::ostream &os) const;
+    };
+
+    /*
+     * Counters of the dominance checks and insertions done by DominancePruningPrevious on its database. Every
+     * interval expansions, a snapshot is appended to the output file as a single line of JSON, so that the
+     * evolution of the hit rate and the cost of the database can be followed during the search:
+     *
+     *   {"expansions": ..., "time": ..., "checked": ..., "dominated": ..., "hit_rate": ..., "inserted": ...,
+     *    "size": ..., "size_growth": ..., "check_latency": {...}, "insert_latency": {...},
+     *    "g_layers": [{"g": ..., "checked": ..., "dominated": ...}, ...]}
+     *
+     * Counters are cumulative, except size_growth, which is the change in the size of the database since the
+     * previous snapshot. The latencies are measured per batch, i.e., per expansion.
+     */
+    class DatabaseStatistics {
+        const int interval;
+        std::ofstream output;
+
+        long num_expansions = 0;
+        long num_checked = 0;
+        long num_dominated = 0;
+        long num_inserted = 0;
+        long last_size = 0;
+        bool finished = false;
+        LatencyHistogram check_latency;
+        LatencyHistogram insert_latency;
+        // Number of checked and dominated states for each g value
+        std::vector<long> checked_per_g;
+        std::vector<long> dominated_per_g;
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        DatabaseStatistics(const std::string &filename, int interval);
+
+        void record_check(Clock::duration latency, const std::vector<int> &g_values, const std::vector<bool> &dominated);
+        void record_insert(Clock::duration latency, size_t num_states);
+        // Returns true every interval expansions, when a snapshot should be written
+        bool record_expansion();
+        /*
+         * Appends a snapshot to the output. The size is passed by the caller because it can be expensive to compute
+         * for some databases.
+         */
+        void write_snapshot(long database_size);
+        /*
+         * Writes a last snapshot at the end of the search, unless it was just written. Only the first call has an
+         * effect, so it is safe to call it whenever the statistics are printed.
+         */
+        void finish(long database_size);
+
+        bool is_open() const {
+            return output.is_open();
+        }
+    };
+}
+
+#endif
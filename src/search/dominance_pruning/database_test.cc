@@ -1,28 +1,101 @@
 #include "database_test.h"
 
 #include "../plugins/plugin.h"
+#include "../utils/component_errors.h"
+#include "../utils/logging.h"
+
+#include <iomanip>
 
 namespace dominance {
+    DatabaseTest::DatabaseTest(std::vector<std::unique_ptr<DominanceDatabase>> &&dbs, bool print_states)
+        : dbs(std::move(dbs)), print_states(print_states), check_time(this->dbs.size(), Clock::duration::zero()),
+          insert_time(this->dbs.size(), Clock::duration::zero()), num_checks(0), num_dominated(0), num_inserts(0) {
+    }
+
     void DatabaseTest::insert(const std::vector<int>& transformed_state, int g) {
-        std::cout << "Inserted state " << transformed_state << " with g=" << g << std::endl;
-        for (auto& db : dbs) {
-            db->insert(transformed_state, g);
+        if (print_states) {
+            std::cout << "Inserted state " << transformed_state << " with g=" << g << std::endl;
         }
+        for (size_t i = 0; i < dbs.size(); ++i) {
+            auto start = Clock::now();
+            dbs[i]->insert(transformed_state, g);
+            insert_time[i] += Clock::now() - start;
+        }
+        ++num_inserts;
     }
 
     bool DatabaseTest::check(const ExplicitState &succ_transformed, int g_val) const {
-      bool result = dbs[0]->check(succ_transformed, g_val);
+        auto start = Clock::now();
+        bool result = dbs[0]->check(succ_transformed, g_val);
+        check_time[0] += Clock::now() - start;
         for (size_t i = 1; i < dbs.size(); ++i) {
-            if (dbs[i]->check(succ_transformed, g_val) != result) {
+            start = Clock::now();
+            bool other_result = dbs[i]->check(succ_transformed, g_val);
+            check_time[i] += Clock::now() - start;
+            if (other_result != result) {
                 std::cout << "Databases disagree on state " << succ_transformed << " with g=" << g_val << std::endl;
                 utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
-            }else {
+            }else if (print_states) {
                 std::cout << "Databases agree on state " << succ_transformed << " with g=" << g_val << std::endl;
             }
         }
+        ++num_checks;
+        num_dominated += result;
         return result;
     }
 
+    void DatabaseTest::check_batch(const std::vector<ExplicitState> &states, const std::vector<int> &g_values,
+                                   std::vector<bool> &dominated) const {
+        // The batch versions are compared and timed, since they are the ones used by the pruning method
+        for (size_t i = 0; i < dbs.size(); ++i) {
+            std::vector<bool> &result = i == 0 ? dominated : other_dominated;
+            auto start = Clock::now();
+            dbs[i]->check_batch(states, g_values, result);
+            check_time[i] += Clock::now() - start;
+            for (size_t j = 0; i > 0 && j < states.size(); ++j) {
+                if (result[j] != dominated[j]) {
+                    std::cout << "Databases disagree on state " << states[j] << " with g=" << g_values[j] << std::endl;
+                    utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+                }
+            }
+        }
+        if (print_states) {
+            for (size_t j = 0; j < states.size(); ++j) {
+                std::cout << "Databases agree on state " << states[j] << " with g=" << g_values[j] << std::endl;
+            }
+        }
+        num_checks += states.size();
+        num_dominated += std::ranges::count(dominated, true);
+    }
+
+    void DatabaseTest::insert_batch(const std::vector<ExplicitState> &transformed_states,
+                                    const std::vector<int> &g_values) {
+        if (print_states) {
+            for (size_t j = 0; j < transformed_states.size(); ++j) {
+                std::cout << "Inserted state " << transformed_states[j] << " with g=" << g_values[j] << std::endl;
+            }
+        }
+        for (size_t i = 0; i < dbs.size(); ++i) {
+            auto start = Clock::now();
+            dbs[i]->insert_batch(transformed_states, g_values);
+            insert_time[i] += Clock::now() - start;
+        }
+        num_inserts += transformed_states.size();
+    }
+
+    void DatabaseTest::print_statistics(utils::LogProxy &log) const {
+        using Seconds = std::chrono::duration<double>;
+        log << "Database test: " << num_checks << " checks (" << num_dominated << " dominated), "
+            << num_inserts << " inserts" << std::endl;
+        for (size_t i = 0; i < dbs.size(); ++i) {
+            log << "Database " << i << ": check time " << std::fixed << std::setprecision(3)
+                << std::chrono::duration_cast<Seconds>(check_time[i]).count() << "s, insert time "
+                << std::chrono::duration_cast<Seconds>(insert_time[i]).count() << "s, size " << dbs[i]->get_size()
+                << std::defaultfloat << std::endl;
+            dbs[i]->print_statistics(log);
+        }
+    }
+
 
     class DatabaseTestFactoryFeature
         : public plugins::TypedFeature<DominanceDatabaseFactory, DatabaseTestFactory> {
@@ -30,13 +103,22 @@ namespace dominance {
         DatabaseTestFactoryFeature() : TypedFeature("test") {
             document_title("Test");
 
-            document_synopsis("Compares the result of databases.");
+            document_synopsis(
+                "Compares the result of databases. The result of the first database is used for pruning, and the "
+                "search is aborted if any other database disagrees with it. The time each database spends in checks "
+                "and inserts is reported at the end of the search, so it can also be used to compare their "
+                "performance, e.g., with test(dbs=[indexed(), bdd_map(skip_single_states=false)], "
+                "print_states=false). Note that bdd_map() does not detect some duplicates with the default "
+                "skip_single_states=true, and then disagrees with the explicit-state databases.");
 
             add_list_option<std::shared_ptr<DominanceDatabaseFactory>>("dbs", "at least one database");
+            add_option<bool>("print_states", "print every checked and inserted state", "true");
         }
 
         virtual std::shared_ptr<DatabaseTestFactory> create_component(const plugins::Options & opts) const override {
-            return std::make_shared<DatabaseTestFactory>(opts.get_list<std::shared_ptr<DominanceDatabaseFactory>>("dbs"));
+            auto db_factories = opts.get_list<std::shared_ptr<DominanceDatabaseFactory>>("dbs");
+            utils::verify_list_not_empty(db_factories, "dbs");
+            return std::make_shared<DatabaseTestFactory>(std::move(db_factories), opts.get<bool>("print_states"));
         }
     };
 
@@ -1,16 +1,32 @@
-#ifndef DOMINANCE_DATABASE_ALL_PREVIOUS_H
-#define DOMINANCE_DATABASE_ALL_PREVIOUS_H
+#ifndef DOMINANCE_DATABASE_TEST_H
+#define DOMINANCE_DATABASE_TEST_H
 
 #include "dominance_database.h"
 
+#include <chrono>
+
 namespace dominance {
+/*
+ * Forwards every check and insert to several databases, aborts if they disagree on whether a state is dominated,
+ * and reports the time spent by each of them at the end of the search, e.g., to compare indexed() and bdd_map().
+ */
 class DatabaseTest : public DominanceDatabase {
+    using Clock = std::chrono::steady_clock;
 
   std::vector<std::unique_ptr<DominanceDatabase>> dbs;
+  const bool print_states;
+
+    // Time spent in checks and inserts by each database
+    mutable std::vector<Clock::duration> check_time;
+    std::vector<Clock::duration> insert_time;
+    mutable long num_checks;
+    mutable long num_dominated;
+    long num_inserts;
+
+    // Results of the other databases, reused across batches
+    mutable std::vector<bool> other_dominated;
 public:
-    DatabaseTest(std::vector<std::unique_ptr<DominanceDatabase>> && dbs)
-        : dbs(std::move(dbs)) {
-    }
+    DatabaseTest(std::vector<std::unique_ptr<DominanceDatabase>> && dbs, bool print_states);
     virtual ~DatabaseTest() = default;
 
     //Methods to keep dominated states in explicit search
@@ -19,29 +35,39 @@ public:
     //Insert: inserts a state into the set of known states
     void insert(const ExplicitState &transformed_state, int g) override;
 
+    void check_batch(const std::vector<ExplicitState> &states, const std::vector<int> &g_values,
+                     std::vector<bool> &dominated) const override;
+    void insert_batch(const std::vector<ExplicitState> &transformed_states, const std::vector<int> &g_values) override;
+
+    long get_size() const override {
+        return dbs[0]->get_size();
+    }
 
+    void print_statistics(utils::LogProxy &log) const override;
 };
 
     class DatabaseTestFactory : public DominanceDatabaseFactory {
         std::vector<std::shared_ptr<DominanceDatabaseFactory>> db_factories;
+        const bool print_states;
 
     public:
-        DatabaseTestFactory(        std::vector<std::shared_ptr<DominanceDatabaseFactory>> db_factories) : DominanceDatabaseFactory(), db_factories(std::move(db_factories)) {
+        DatabaseTestFactory(        std::vector<std::shared_ptr<DominanceDatabaseFactory>> db_factories, bool print_states) : DominanceDatabaseFactory(), db_factories(std::move(db_factories)), print_states(print_states) {
         }
 
         virtual std::unique_ptr<DominanceDatabase> create(const std::shared_ptr<AbstractTask> & task,
                                                           std::shared_ptr<StateDominanceRelation> dominance_relation,
+                                                          std::shared_ptr<const FrozenDominanceRelation> frozen_relation,
                                                           std::shared_ptr<fts::FactoredStateMapping> mapping) override
         {
             std::vector<std::unique_ptr<DominanceDatabase>> dbs;
 
             for (const auto &db_factory : db_factories) {
-                dbs.push_back(db_factory->create(task, dominance_relation, mapping));
+                dbs.push_back(db_factory->create(task, dominance_relation, frozen_relation, mapping));
             }
-            return std::make_unique<DatabaseTest>(std::move(dbs));
+            return std::make_unique<DatabaseTest>(std::move(dbs), print_states);
         }
     };
 
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,122 @@
+#include "database_trie.h"
+
+#include "../dominance/factor_dominance_relation.h"
+#include "../dominance/state_dominance_relation.h"
+#include "../plugins/plugin.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace dominance {
+    DatabaseTrie::DatabaseTrie(std::shared_ptr<StateDominanceRelation> dominance_relation,
+                               std::shared_ptr<const FrozenDominanceRelation> frozen_relation)
+        : frozen_relation(frozen_relation), num_states(0) {
+        const int num_factors = dominance_relation->size();
+        dominating_values.resize(num_factors);
+        for (int factor = 0; factor < num_factors; ++factor) {
+            const FactorDominanceRelation &relation = (*dominance_relation)[factor];
+            dominating_values[factor].resize(relation.get_num_states());
+            relation.apply_to_simulations_until([&](int s, int t) {
+                dominating_values[factor][t].push_back(s);
+                return false;
+            });
+            for (auto &values : dominating_values[factor]) {
+                std::ranges::sort(values);
+            }
+        }
+        // Root node
+        nodes.emplace_back(std::numeric_limits<int>::max());
+    }
+
+    int DatabaseTrie::get_child(int node, int value) const {
+        const auto &children = nodes[node].children;
+        auto it = std::ranges::lower_bound(children, value, {}, &std::pair<int, int>::first);
+        if (it == children.end() || it->first != value) {
+            return -1;
+        }
+        return it->second;
+    }
+
+    void DatabaseTrie::insert(const ExplicitState &transformed_state, int g) {
+        int node = 0;
+        nodes[node].min_g = std::min(nodes[node].min_g, g);
+        for (size_t factor = 0; factor < dominating_values.size(); ++factor) {
+            int value = transformed_state[factor];
+            int child = get_child(node, value);
+            if (child == -1) {
+                child = nodes.size();
+                // May reallocate nodes, so the children of node are accessed afterwards
+                nodes.emplace_back(g);
+                auto &children = nodes[node].children;
+                auto it = std::ranges::lower_bound(children, value, {}, &std::pair<int, int>::first);
+                children.emplace(it, value, child);
+                if (factor + 1 == dominating_values.size()) {
+                    ++num_states;
+                }
+            } else {
+                nodes[child].min_g = std::min(nodes[child].min_g, g);
+            }
+            node = child;
+        }
+    }
+
+    bool DatabaseTrie::check(const ExplicitState &state, int g) const {
+        if (nodes[0].min_g > g) {
+            return false;
+        }
+        const int num_factors = dominating_values.size();
+        open_nodes.clear();
+        open_nodes.emplace_back(0, 0);
+        while (!open_nodes.empty()) {
+            const auto [factor, node] = open_nodes.back();
+            open_nodes.pop_back();
+            if (factor == num_factors) {
+                // A leaf with min_g <= g: a stored state dominates the state
+                return true;
+            }
+
+            const auto &children = nodes[node].children;
+            const auto &dominating = dominating_values[factor][state[factor]];
+            auto expand = [&](int child) {
+                if (nodes[child].min_g <= g) {
+                    open_nodes.emplace_back(factor + 1, child);
+                }
+            };
+            // Iterate over the shorter of the two lists
+            if (children.size() <= dominating.size()) {
+                for (const auto &[value, child] : children) {
+                    if (frozen_relation->simulates(factor, value, state[factor])) {
+                        expand(child);
+                    }
+                }
+            } else {
+                for (int value : dominating) {
+                    int child = get_child(node, value);
+                    if (child != -1) {
+                        expand(child);
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    class DatabaseTrieFactoryFeature
+        : public plugins::TypedFeature<DominanceDatabaseFactory, DatabaseTrieFactory> {
+    public:
+        DatabaseTrieFactoryFeature() : TypedFeature("trie") {
+            document_title("Trie Database");
+
+            document_synopsis(
+                "Stores the previous states in a trie with one level per factor. A new state is checked by descending "
+                "only into the children whose value simulates the value of the new state in that factor, skipping "
+                "the subtrees whose states all have a larger g value. Does not depend on CUDD.");
+        }
+
+        virtual std::shared_ptr<DatabaseTrieFactory> create_component(const plugins::Options &) const override {
+            return std::make_shared<DatabaseTrieFactory>();
+        }
+    };
+
+    static plugins::FeaturePlugin<DatabaseTrieFactoryFeature> _plugin;
+}
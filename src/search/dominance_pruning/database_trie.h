@@ -0,0 +1,67 @@
+#ifndef DOMINANCE_DATABASE_TRIE_H
+#define DOMINANCE_DATABASE_TRIE_H
+
+#include <utility>
+
+#include "dominance_database.h"
+#include "../dominance/frozen_dominance_relation.h"
+
+namespace dominance {
+    /*
+     * Stores the states in a trie with one level per factor. A check descends only into the children whose value
+     * simulates the value of the state in the factor, using the precomputed list of dominating values of each
+     * factor, and skips the subtrees where all states have been reached with a larger g value.
+     */
+    class DatabaseTrie : public DominanceDatabase {
+        struct Node {
+            // Pairs (value, child node) sorted by value
+            std::vector<std::pair<int, int>> children;
+            // Minimum g value of the states stored below this node
+            int min_g;
+
+            explicit Node(int g) : min_g(g) {
+            }
+        };
+
+        std::shared_ptr<const FrozenDominanceRelation> frozen_relation;
+        // dominating_values[factor][v]: values of the factor that simulate v
+        std::vector<std::vector<std::vector<int>>> dominating_values;
+        std::vector<Node> nodes;
+        // Number of distinct states, i.e., of leaves
+        long num_states;
+
+        // Pairs (factor, node) that must still be explored, reused across checks
+        mutable std::vector<std::pair<int, int>> open_nodes;
+
+        [[nodiscard]] int get_child(int node, int value) const;
+    public:
+        DatabaseTrie(std::shared_ptr<StateDominanceRelation> dominance_relation,
+                     std::shared_ptr<const FrozenDominanceRelation> frozen_relation);
+        virtual ~DatabaseTrie() = default;
+
+        //Check: returns true if a better or equal state is known
+        bool check(const ExplicitState &state, int g) const override;
+        //Insert: inserts a state into the set of known states
+        void insert(const ExplicitState &transformed_state, int g) override;
+
+        long get_size() const override {
+            return num_states;
+        }
+    };
+
+    class DatabaseTrieFactory : public DominanceDatabaseFactory {
+    public:
+        DatabaseTrieFactory() : DominanceDatabaseFactory() {
+        }
+
+        virtual std::unique_ptr<DominanceDatabase> create(const std::shared_ptr<AbstractTask> &,
+                                                          std::shared_ptr<StateDominanceRelation> dominance_relation,
+                                                          std::shared_ptr<const FrozenDominanceRelation> frozen_relation,
+                                                          std::shared_ptr<fts::FactoredStateMapping> ) override
+        {
+            return std::make_unique<DatabaseTrie>(dominance_relation, frozen_relation);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,163 @@
+#include "dominance_cache.h"
+
+#include "../dominance/dominance_analysis.h"
+#include "../dominance/factor_dominance_relation.h"
+#include "../dominance/label_relation.h"
+#include "../dominance/state_dominance_relation.h"
+#include "../factored_transition_system/factored_state_mapping.h"
+#include "../factored_transition_system/fts_task.h"
+#include "../task_proxy.h"
+#include "../utils/binary_file.h"
+#include "../utils/hash.h"
+#include "../utils/logging.h"
+#include "../utils/timer.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+
+namespace dominance {
+    // Must be increased whenever the content of the files changes
+    static const uint32_t CACHE_FORMAT_VERSION = 1;
+
+    static void feed_string(utils::HashState &hash_state, const string &value) {
+        utils::feed(hash_state, static_cast<uint64_t>(value.size()));
+        for (char c : value) {
+            utils::feed(hash_state, static_cast<int>(c));
+        }
+    }
+
+    DominanceCache::DominanceCache(const string &directory, const string &config)
+        : directory(directory), config(config) {
+    }
+
+    uint64_t DominanceCache::compute_key(const AbstractTask &task) const {
+        TaskProxy task_proxy(task);
+        utils::HashState hash_state;
+        feed_string(hash_state, config);
+
+        VariablesProxy variables = task_proxy.get_variables();
+        utils::feed(hash_state, static_cast<int>(variables.size()));
+        for (VariableProxy var : variables) {
+            feed_string(hash_state, var.get_name());
+            utils::feed(hash_state, var.get_domain_size());
+            for (int value = 0; value < var.get_domain_size(); ++value) {
+                feed_string(hash_state, var.get_fact(value).get_name());
+            }
+        }
+
+        OperatorsProxy operators = task_proxy.get_operators();
+        utils::feed(hash_state, static_cast<int>(operators.size()));
+        for (OperatorProxy op : operators) {
+            feed_string(hash_state, op.get_name());
+            utils::feed(hash_state, op.get_cost());
+            for (FactProxy pre : op.get_preconditions()) {
+                utils::feed(hash_state, pre.get_pair());
+            }
+            utils::feed(hash_state, -1);
+            for (EffectProxy eff : op.get_effects()) {
+                for (FactProxy cond : eff.get_conditions()) {
+                    utils::feed(hash_state, cond.get_pair());
+                }
+                utils::feed(hash_state, -1);
+                utils::feed(hash_state, eff.get_fact().get_pair());
+            }
+            utils::feed(hash_state, -1);
+        }
+
+        for (FactProxy goal : task_proxy.get_goals()) {
+            utils::feed(hash_state, goal.get_pair());
+        }
+        utils::feed(hash_state, task_proxy.get_initial_state().get_unpacked_values());
+        return hash_state.get_hash64();
+    }
+
+    string DominanceCache::get_path(uint64_t key) const {
+        ostringstream path;
+        path << directory << "/dominance-" << hex << setw(16) << setfill('0') << key << ".bin";
+        return path.str();
+    }
+
+    optional<DominanceCache::Entry> DominanceCache::load(const shared_ptr<AbstractTask> &task,
+                                                         DominanceAnalysis &dominance_analysis,
+                                                         utils::LogProxy &log) const {
+        utils::Timer timer;
+        const uint64_t key = compute_key(*task);
+        const string path = get_path(key);
+        utils::MappedFile file(path);
+        if (!file.is_open()) {
+            return nullopt;
+        }
+
+        try {
+            utils::BinaryReader reader = file.get_reader();
+            reader.check_header(CACHE_FORMAT_VERSION, key);
+            auto fts_task = make_unique<fts::FTSTask>(reader, task);
+            auto state_mapping = fts::FactoredStateMapping::load(reader);
+
+            vector<vector<pair<int, int>>> simulations(fts_task->get_num_variables());
+            for (auto &pairs : simulations) {
+                vector<int> sources = reader.read_vector<int>();
+                vector<int> targets = reader.read_vector<int>();
+                if (sources.size() != targets.size()) {
+                    throw utils::BinaryFileError("inconsistent simulation pairs");
+                }
+                pairs.reserve(sources.size());
+                for (size_t i = 0; i < sources.size(); ++i) {
+                    pairs.emplace_back(sources[i], targets[i]);
+                }
+            }
+            if (!reader.at_end()) {
+                throw utils::BinaryFileError("trailing data");
+            }
+
+            auto relation = dominance_analysis.restore_dominance_relation(*fts_task, simulations);
+            if (!relation) {
+                log << "Ignoring dominance cache " << path << ": relation cannot be restored" << endl;
+                return nullopt;
+            }
+            log << "Dominance relation loaded from " << path << ": " << timer << endl;
+            return Entry{fts::TransformedFTSTask(std::move(fts_task), std::move(state_mapping)), std::move(relation)};
+        } catch (const utils::BinaryFileError &error) {
+            log << "Ignoring dominance cache " << path << ": " << error.get_message() << endl;
+            return nullopt;
+        }
+    }
+
+    void DominanceCache::save(const shared_ptr<AbstractTask> &task, const fts::TransformedFTSTask &transformed_task,
+                              const StateDominanceRelation &dominance_relation, utils::LogProxy &log) const {
+        const uint64_t key = compute_key(*task);
+        utils::BinaryWriter writer(CACHE_FORMAT_VERSION, key);
+        transformed_task.fts_task->save(writer);
+        transformed_task.factored_state_mapping->save(writer);
+
+        for (const auto &relation : dominance_relation.get_local_relations()) {
+            vector<pair<int, int>> pairs;
+            relation->apply_to_simulations_until([&](int s, int t) {
+                if (s != t) {
+                    pairs.emplace_back(s, t);
+                }
+                return false;
+            });
+            ranges::sort(pairs);
+            vector<int> sources, targets;
+            sources.reserve(pairs.size());
+            targets.reserve(pairs.size());
+            for (const auto &[s, t] : pairs) {
+                sources.push_back(s);
+                targets.push_back(t);
+            }
+            writer.write_vector(sources);
+            writer.write_vector(targets);
+        }
+
+        const string path = get_path(key);
+        if (writer.save(path)) {
+            log << "Dominance relation stored in " << path << endl;
+        } else {
+            log << "Could not write dominance cache " << path << endl;
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef DOMINANCE_DOMINANCE_CACHE_H
+#define DOMINANCE_DOMINANCE_CACHE_H
+
+#include "../factored_transition_system/fts_task_factory.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+class AbstractTask;
+
+namespace utils {
+    class LogProxy;
+}
+
+namespace dominance {
+    class DominanceAnalysis;
+    class StateDominanceRelation;
+
+    /*
+     * Stores the FTS task, the state mapping and the dominance relation computed for a planning task on disk, so
+     * that later runs on the same task with the same configuration can skip the preprocessing. Files are named after
+     * a hash of the task and of the configuration strings of the FTS factory and the dominance analysis, and the hash
+     * is checked again on loading. Files that cannot be read are ignored, so the cache never changes the result of a run.
+     */
+    class DominanceCache {
+        std::string directory;
+        std::string config;
+
+        std::uint64_t compute_key(const AbstractTask &task) const;
+        std::string get_path(std::uint64_t key) const;
+    public:
+        struct Entry {
+            fts::TransformedFTSTask transformed_task;
+            std::unique_ptr<StateDominanceRelation> dominance_relation;
+        };
+
+        DominanceCache(const std::string &directory, const std::string &config);
+
+        std::optional<Entry> load(const std::shared_ptr<AbstractTask> &task, DominanceAnalysis &dominance_analysis,
+                                  utils::LogProxy &log) const;
+
+        void save(const std::shared_ptr<AbstractTask> &task, const fts::TransformedFTSTask &transformed_task,
+                  const StateDominanceRelation &dominance_relation, utils::LogProxy &log) const;
+    };
+}
+
+#endif
@@ -3,6 +3,20 @@
 #include "../plugins/plugin.h"
 
 namespace dominance {
+    void DominanceDatabase::check_batch(const std::vector<ExplicitState> &states, const std::vector<int> &g_values,
+                                        std::vector<bool> &dominated) const {
+        dominated.resize(states.size());
+        for (size_t i = 0; i < states.size(); ++i) {
+            dominated[i] = check(states[i], g_values[i]);
+        }
+    }
+
+    void DominanceDatabase::insert_batch(const std::vector<ExplicitState> &transformed_states, const std::vector<int> &g_values) {
+        for (size_t i = 0; i < transformed_states.size(); ++i) {
+            insert(transformed_states[i], g_values[i]);
+        }
+    }
+
     static class DominanceDatabaseFactoryCategoryPlugin : public plugins::TypedCategoryPlugin<DominanceDatabaseFactory> {
     public:
         DominanceDatabaseFactoryCategoryPlugin() : TypedCategoryPlugin("DominanceDatabaseFactory") {
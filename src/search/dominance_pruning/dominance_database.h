@@ -10,7 +10,12 @@ namespace fts {
     class FactoredStateMapping;
 }
 
+namespace utils {
+    class LogProxy;
+}
+
 namespace dominance {
+    class FrozenDominanceRelation;
     class StateDominanceRelation;
     typedef std::vector<int> ExplicitState;
 
@@ -19,13 +24,36 @@ namespace dominance {
         virtual ~DominanceDatabase() = default;
         virtual bool check(const ExplicitState &state, int g) const = 0;
         virtual void insert(const ExplicitState &transformed_state, int g) = 0;
+
+        /*
+         * Batch versions of check and insert for all successors of an expansion. dominated[i] is set to the result
+         * of check(states[i], g_values[i]). The default implementations handle one state at a time; databases can
+         * override them to share work across the batch.
+         */
+        virtual void check_batch(const std::vector<ExplicitState> &states, const std::vector<int> &g_values,
+                                 std::vector<bool> &dominated) const;
+        virtual void insert_batch(const std::vector<ExplicitState> &transformed_states, const std::vector<int> &g_values);
+
+        // Size of the stored data for statistics: BDD nodes for symbolic databases, states otherwise. -1 if unknown.
+        virtual long get_size() const {
+            return -1;
+        }
+
+        // Called once by the pruning method at the end of the search
+        virtual void print_statistics(utils::LogProxy &) const {
+        }
     };
 
     class DominanceDatabaseFactory {
     public:
         virtual ~DominanceDatabaseFactory() = default;
+        /*
+         * frozen_relation is the read-only copy of dominance_relation shared by the pruning method and all
+         * databases, so that it is built only once.
+         */
         virtual std::unique_ptr<DominanceDatabase> create(const std::shared_ptr<AbstractTask> &task,
                                                           std::shared_ptr<StateDominanceRelation> dominance_relation,
+                                                          std::shared_ptr<const FrozenDominanceRelation> frozen_relation,
                                                           std::shared_ptr<fts::FactoredStateMapping> state_mapping) = 0;
     };
 }
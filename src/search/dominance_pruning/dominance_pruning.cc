@@ -1,5 +1,7 @@
 #include "dominance_pruning.h"
 
+#include "dominance_cache.h"
+
 #include "../plugins/options.h"
 #include "../plugins/plugin.h"
 
@@ -16,8 +18,9 @@ namespace dominance {
 
     DominancePruning::DominancePruning(const std::shared_ptr<fts::FTSTaskFactory> & fts_factory,
                                        std::shared_ptr<DominanceAnalysis> dominance_analysis,
+                                       std::shared_ptr<DominanceCache> cache,
                                        utils::Verbosity verbosity) :
-    PruningMethod(verbosity), fts_factory(fts_factory), dominance_analysis(dominance_analysis) {
+    PruningMethod(verbosity), fts_factory(fts_factory), dominance_analysis(dominance_analysis), cache(cache) {
     }
 
     void DominancePruning::initialize(const std::shared_ptr<AbstractTask> &task) {
@@ -25,10 +28,23 @@ namespace dominance {
         PruningMethod::initialize(task);
 
 
-        fts::TransformedFTSTask transformed_task = fts_factory->transform_to_fts(task);
+        std::optional<DominanceCache::Entry> cached;
+        if (cache) {
+            cached = cache->load(task, *dominance_analysis, log);
+        }
+        if (!cached) {
+            fts::TransformedFTSTask computed_task = fts_factory->transform_to_fts(task);
+            auto computed_relation = dominance_analysis->compute_dominance_relation(*computed_task.fts_task);
+            if (cache) {
+                cache->save(task, computed_task, *computed_relation, log);
+            }
+            cached.emplace(std::move(computed_task), std::move(computed_relation));
+        }
+        fts::TransformedFTSTask &transformed_task = cached->transformed_task;
         state_mapping = std::move(transformed_task.factored_state_mapping);
 
-        dominance_relation = dominance_analysis->compute_dominance_relation(*transformed_task.fts_task);
+        dominance_relation = std::move(cached->dominance_relation);
+        frozen_relation = std::make_shared<const FrozenDominanceRelation>(*dominance_relation);
 
         if (log.is_at_least_verbose()){
             dominance_relation->dump_statistics(log);
@@ -53,12 +69,31 @@ namespace dominance {
                 "Strategy to obtain a dominance relation",
                 "ld_simulation()");
 
+        feature.add_option<string>(
+                "cache_directory",
+                "Directory where the FTS task and the dominance relation are stored after computing them, and from "
+                "which they are loaded in later runs on the same task with the same configuration. "
+                "The empty string disables the cache.",
+                "\"\"");
+
         add_pruning_options_to_feature(feature);
     }
 
-    tuple<std::shared_ptr<fts::FTSTaskFactory>, std::shared_ptr<DominanceAnalysis>, utils::Verbosity> get_dominance_pruning_arguments_from_options(const plugins::Options &opts) {
-        return tuple_cat(make_tuple(opts.get<std::shared_ptr<fts::FTSTaskFactory>>("fts_factory"),
-                                    opts.get<std::shared_ptr<DominanceAnalysis>>("dominance_analysis")),
+    tuple<std::shared_ptr<fts::FTSTaskFactory>, std::shared_ptr<DominanceAnalysis>, std::shared_ptr<DominanceCache>, utils::Verbosity> get_dominance_pruning_arguments_from_options(const plugins::Options &opts) {
+        auto fts_factory = opts.get<std::shared_ptr<fts::FTSTaskFactory>>("fts_factory");
+        auto dominance_analysis = opts.get<std::shared_ptr<DominanceAnalysis>>("dominance_analysis");
+        std::shared_ptr<DominanceCache> cache;
+        const string cache_directory = opts.get<string>("cache_directory");
+        if (!cache_directory.empty()) {
+            /*
+             * Only the configurations of the FTS factory and the dominance analysis determine the cached data, so
+             * the other options of the pruning method (database, verbosity, cache directory...) are not part of
+             * the key.
+             */
+            cache = std::make_shared<DominanceCache>(
+                    cache_directory, fts_factory->get_config() + "\n" + dominance_analysis->get_config());
+        }
+        return tuple_cat(make_tuple(fts_factory, dominance_analysis, cache),
                          get_pruning_arguments_from_options(opts));
     }
 
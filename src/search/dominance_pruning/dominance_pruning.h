@@ -7,6 +7,7 @@
 #include <set>
 
 #include "../pruning_method.h"
+#include "../dominance/frozen_dominance_relation.h"
 #include "../dominance/state_dominance_relation.h"
 #include "../dominance/dominance_analysis.h"
 #include "../factored_transition_system/fts_task_factory.h"
@@ -21,14 +22,19 @@ namespace fts {
 }
 
 namespace dominance {
+    class DominanceCache;
 
     class  DominancePruning : public PruningMethod {
     protected:
         std::shared_ptr<fts::FTSTaskFactory> fts_factory;
         std::shared_ptr<DominanceAnalysis> dominance_analysis;
+        // Stores the preprocessing results on disk (nullptr if disabled)
+        std::shared_ptr<DominanceCache> cache;
 
         //TODO: This will be separated on a TaskDependentPruningMethod when the refactoring from FastDownward is completed
         std::shared_ptr<StateDominanceRelation> dominance_relation;
+        // Read-only copy of dominance_relation used to check states during the search, shared with the database
+        std::shared_ptr<const FrozenDominanceRelation> frozen_relation;
         std::shared_ptr<fts::FactoredStateMapping> state_mapping;
 
         void dump_options() const;
@@ -36,6 +42,7 @@ namespace dominance {
     public:
         DominancePruning(const std::shared_ptr<fts::FTSTaskFactory> & fts_factory,
                          std::shared_ptr<DominanceAnalysis> dominance_analysis,
+                         std::shared_ptr<DominanceCache> cache,
                          utils::Verbosity verbosity);
 
         virtual ~DominancePruning() = default;
@@ -44,7 +51,7 @@ namespace dominance {
     };
 
     extern void add_dominance_pruning_options_to_feature(plugins::Feature &feature);
-    extern std::tuple<std::shared_ptr<fts::FTSTaskFactory>,std::shared_ptr<DominanceAnalysis>, utils::Verbosity> get_dominance_pruning_arguments_from_options(
+    extern std::tuple<std::shared_ptr<fts::FTSTaskFactory>,std::shared_ptr<DominanceAnalysis>, std::shared_ptr<DominanceCache>, utils::Verbosity> get_dominance_pruning_arguments_from_options(
             const plugins::Options &opts);
 
 }
@@ -12,8 +12,9 @@ namespace dominance {
     DominancePruningLocal::DominancePruningLocal(bool compare_initial_state, bool compare_siblings,
                                                  const std::shared_ptr<fts::FTSTaskFactory> & fts_factory,
                                                  std::shared_ptr<DominanceAnalysis> dominance_analysis,
+                                                 std::shared_ptr<DominanceCache> cache,
                                                  utils::Verbosity verbosity) :
-            DominancePruning(fts_factory, dominance_analysis, verbosity),
+            DominancePruning(fts_factory, dominance_analysis, cache, verbosity),
             compare_initial_state(compare_initial_state),
             compare_siblings (compare_siblings) {
     }
@@ -31,10 +32,9 @@ namespace dominance {
                                                     const vector<int> & parent,
                                                     const vector<int> & parent_transformed,
                                                     vector<int> & succ,
-                                                    vector<int> & succ_transformed) const {
-        // TODO (efficiency): Probably it's more efficient to use some kind of flat set for affected_factors based on a sorted vector
-        // given that we insert very few elements
-        vector<int> updated_variables;
+                                                    vector<int> & succ_transformed) {
+        updated_variables.clear();
+        updated_factors.clear();
         for (EffectProxy effect : op.get_effects()) {
             if (does_fire(effect, state)) {
                 FactPair effect_fact = effect.get_fact().get_pair();
@@ -43,23 +43,24 @@ namespace dominance {
             }
         }
         assert(state_mapping);
-        auto maybe_affected_factors = state_mapping->update_transformation_in_place(succ_transformed, succ, updated_variables); 
-
-        bool must_prune = false;
-        if(!maybe_affected_factors.has_value()) {
-            must_prune = true;
-        } else{
+        bool must_prune = !state_mapping->update_transformation_in_place(succ_transformed, succ, updated_variables,
+                                                                         updated_factors);
+        if (!must_prune) {
             // Is dominated by parent?
-            must_prune = std::ranges::all_of(maybe_affected_factors.value(),
-                                             [&](const auto & factor) {
-                                                 return (*dominance_relation)[factor].simulates(parent_transformed[factor],
-                                                                                                succ_transformed[factor]);
+            must_prune = std::ranges::all_of(updated_factors,
+                                             [&](int factor) {
+                                                 return frozen_relation->simulates(factor, parent_transformed[factor],
+                                                                                   succ_transformed[factor]);
                                              });
         }
 
-        //TODO (efficiency): update only affected_variables and factors for efficiency reasons?
-        succ = parent;
-        succ_transformed = parent_transformed;
+        // Only the entries changed by the operator differ from the parent
+        for (int var : updated_variables) {
+            succ[var] = parent[var];
+        }
+        for (int factor : updated_factors) {
+            succ_transformed[factor] = parent_transformed[factor];
+        }
         return must_prune;
     }
 
@@ -9,18 +9,22 @@ namespace dominance {
         const bool compare_initial_state;
         const bool compare_siblings;
 
+        // Buffers reused across operators, so that no memory is allocated per successor
+        std::vector<int> updated_variables;
+        std::vector<int> updated_factors;
 
         bool must_prune_operator(const OperatorProxy & op,
                                  const State & state,
                                  const std::vector<int> & parent,
                                  const std::vector<int> & parent_transformed,
                                  std::vector<int> & succ,
-                                 std::vector<int> & succ_transformed) const;
+                                 std::vector<int> & succ_transformed);
 
     public:
         DominancePruningLocal(bool compare_initial_state, bool compare_siblings,
                               const std::shared_ptr<fts::FTSTaskFactory> & fts_factory,
                               std::shared_ptr<DominanceAnalysis> dominance_analysis,
+                              std::shared_ptr<DominanceCache> cache,
                               utils::Verbosity verbosity);
         virtual ~DominancePruningLocal() = default;
 
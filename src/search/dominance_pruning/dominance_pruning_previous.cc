@@ -15,10 +15,13 @@ namespace dominance {
     /////////////////////////////////////////////
 
     DominancePruningPrevious::DominancePruningPrevious(std::shared_ptr<DominanceDatabaseFactory> database_factory,
+    int statistics_interval, const std::string &statistics_file,
     const std::shared_ptr<fts::FTSTaskFactory> &fts_factory,
     std::shared_ptr<DominanceAnalysis> dominance_analysis,
+    std::shared_ptr<DominanceCache> cache,
     utils::Verbosity verbosity)
-    : DominancePruning(fts_factory, dominance_analysis, verbosity), database_factory(database_factory) {
+    : DominancePruning(fts_factory, dominance_analysis, cache, verbosity), database_factory(database_factory),
+      statistics_interval(statistics_interval), statistics_file(statistics_file) {
     }
 
     void DominancePruningPrevious::initialize(const std::shared_ptr<AbstractTask> &task) {
@@ -27,77 +30,144 @@ namespace dominance {
         TaskProxy task_proxy(*task);
         State initial(task_proxy.get_initial_state());
 
-        database = database_factory->create(task, dominance_relation, state_mapping);
+        database = database_factory->create(task, dominance_relation, frozen_relation, state_mapping);
         database->insert(state_mapping->transform(initial.get_unpacked_values()), 0);
 
+        if (statistics_interval > 0) {
+            statistics = std::make_unique<DatabaseStatistics>(statistics_file, statistics_interval);
+            if (!statistics->is_open()) {
+                log << "Could not open " << statistics_file << ", database statistics disabled" << endl;
+                statistics.reset();
+            }
+        }
+
         log << "Dominance pruning initialized" << endl;
     }
 
     void DominancePruningPrevious::prune_generation(const State &state, const SearchNodeInfo &node_info, std::vector<OperatorID> &op_ids) {
         state.unpack();
         const vector<int> & parent = state.get_unpacked_values();
-        vector<int> parent_transformed = state_mapping->transform(parent);
+        parent_transformed = state_mapping->transform(parent);
 
-        vector<int> succ = parent;
-        vector<int> succ_transformed = parent_transformed;
+        // Copy assignments reuse the memory of the previous expansion
+        succ = parent;
+        succ_transformed = parent_transformed;
 
         TaskProxy tp (*task);
 
-        const auto [first, last] = std::ranges::remove_if(op_ids,
-                                                          [&] (const auto & op_id) {
-            return must_prune_operator(tp.get_operators()[op_id], state, parent, parent_transformed, succ, succ_transformed, node_info.g);
-        });
+        // Successors that are not dominated by the parent are checked against the database all at once
+        vector<bool> pruned(op_ids.size(), false);
+        vector<ExplicitState> batch_states;
+        vector<int> batch_g_values;
+        vector<size_t> batch_op_index;
+        for (size_t i = 0; i < op_ids.size(); ++i) {
+            OperatorProxy op = tp.get_operators()[op_ids[i]];
+            if (is_dominated_by_parent(op, state)) {
+                pruned[i] = true;
+            } else {
+                batch_states.push_back(succ_transformed);
+                batch_g_values.push_back(node_info.g + op.get_cost());
+                batch_op_index.push_back(i);
+            }
+            reset_successor(parent);
+        }
+
+        vector<bool> dominated;
+        if (statistics) {
+            auto start = DatabaseStatistics::Clock::now();
+            database->check_batch(batch_states, batch_g_values, dominated);
+            statistics->record_check(DatabaseStatistics::Clock::now() - start, batch_g_values, dominated);
+        } else {
+            database->check_batch(batch_states, batch_g_values, dominated);
+        }
+
+        /*
+          A successor can also be dominated by a previous successor of the same expansion that was not pruned (when
+          checking one operator at a time, it would already have been inserted in the database).
+        */
+        vector<ExplicitState> inserted_states;
+        vector<int> inserted_g_values;
+        for (size_t j = 0; j < batch_states.size(); ++j) {
+            if (!dominated[j]) {
+                for (size_t k = 0; k < inserted_states.size(); ++k) {
+                    if (inserted_g_values[k] <= batch_g_values[j] &&
+                        frozen_relation->dominates(inserted_states[k], batch_states[j])) {
+                        dominated[j] = true;
+                        break;
+                    }
+                }
+            }
+            if (dominated[j]) {
+                pruned[batch_op_index[j]] = true;
+            } else {
+                inserted_states.push_back(std::move(batch_states[j]));
+                inserted_g_values.push_back(batch_g_values[j]);
+            }
+        }
 
-        op_ids.erase(first, last);
+        // Store the newly generated states
+        if (statistics) {
+            auto start = DatabaseStatistics::Clock::now();
+            database->insert_batch(inserted_states, inserted_g_values);
+            statistics->record_insert(DatabaseStatistics::Clock::now() - start, inserted_states.size());
+            if (statistics->record_expansion()) {
+                statistics->write_snapshot(database->get_size());
+            }
+        } else {
+            database->insert_batch(inserted_states, inserted_g_values);
+        }
+
+        size_t num_kept = 0;
+        for (size_t i = 0; i < op_ids.size(); ++i) {
+            if (!pruned[i]) {
+                op_ids[num_kept++] = op_ids[i];
+            }
+        }
+        op_ids.erase(op_ids.begin() + num_kept, op_ids.end());
+    }
+
+    void DominancePruningPrevious::print_statistics() const {
+        PruningMethod::print_statistics();
+        if (database) {
+            database->print_statistics(log);
+        }
+        if (statistics) {
+            statistics->finish(database->get_size());
+            log << "Dominance database statistics written to " << statistics_file << endl;
+        }
     }
 
-    bool DominancePruningPrevious::must_prune_operator(const OperatorProxy & op,
-                                                          const State & state,
-                                                          const ExplicitState & parent,
-                                                          const ExplicitState & parent_transformed,
-                                                          ExplicitState & succ,
-                                                          ExplicitState & succ_transformed,
-                                                          int g_value)  {
-        ExplicitState updated_variables; // Vector that will keep track of the variables in the state that have been updated by the current operator
-        // Iterate through all effects of the operator op, applies those that fire and updates the succ state and updated_variables
+    bool DominancePruningPrevious::is_dominated_by_parent(const OperatorProxy & op, const State & state) {
+        // Apply the effects that fire, keeping track of the variables that have been updated
+        updated_variables.clear();
+        updated_factors.clear();
         for (EffectProxy effect : op.get_effects()) {
             if (does_fire(effect, state)) {
-                FactPair effect_fact = effect.get_fact().get_pair(); // retrieves the fact associated with the effect (a pairavar-value)
-                succ[effect_fact.var] = effect_fact.value; //  updates the succ state at the position of the variable effect_fact.var with the new value effect_fact.value
+                FactPair effect_fact = effect.get_fact().get_pair();
+                succ[effect_fact.var] = effect_fact.value;
                 updated_variables.push_back(effect_fact.var);
             }
         }
         assert(state_mapping);
-        //List of updated variables that changed. To determine which parts (factors) of the transformed state were affected and should be checked for dominance?
-        auto maybe_affected_factors = state_mapping->update_transformation_in_place(succ_transformed, succ, updated_variables);
-
-        bool must_prune = false;
-        if (!maybe_affected_factors.has_value()) {
-            must_prune = true;
-        } else {
-            // Check if the new state is dominated by the parent state
-            // Returns true if all factors are dominated by the parent state
-            must_prune = std::ranges::all_of(maybe_affected_factors.value(),
-                                             [&](const auto & factor) {
-                                                 return (*dominance_relation)[factor].simulates(parent_transformed[factor],
-                                                                                                succ_transformed[factor]);
-                                             });
+        // Recompute only the factors that depend on the updated variables
+        if (!state_mapping->update_transformation_in_place(succ_transformed, succ, updated_variables, updated_factors)) {
+            return true;
         }
+        // The successor is dominated by the parent if the parent simulates it in every affected factor
+        return std::ranges::all_of(updated_factors,
+                                   [&](int factor) {
+                                       return frozen_relation->simulates(factor, parent_transformed[factor],
+                                                                         succ_transformed[factor]);
+                                   });
+    }
 
-        // If the state was not pruned by the parent, compare it against all previous states
-        if (!must_prune) {
-            must_prune = database->check(succ_transformed, g_value + op.get_cost());
+    void DominancePruningPrevious::reset_successor(const ExplicitState & parent) {
+        for (int var : updated_variables) {
+            succ[var] = parent[var];
         }
-
-        // Store the newly generated state
-        if (!must_prune) {
-            database->insert(succ_transformed, g_value + op.get_cost());
+        for (int factor : updated_factors) {
+            succ_transformed[factor] = parent_transformed[factor];
         }
-
-        // Reset succ and succ_transformed for the next operator
-        succ = parent;
-        succ_transformed = parent_transformed;
-        return must_prune;
     }
 
 
@@ -118,12 +188,23 @@ namespace dominance {
             // Removed the options for comparing initial state and siblings
             add_dominance_pruning_options_to_feature(*this);
             add_option<std::shared_ptr<DominanceDatabaseFactory>>("database", "Database to store the explored states", "bdd_map()");
+            add_option<int>("statistics_interval",
+                            "Write a snapshot of the counters, latency histograms, size and hit rates per g value of "
+                            "the database every this many expansions, as one line of JSON. 0 disables the statistics, "
+                            "which avoids measuring the time of each check.",
+                            "0",
+                            plugins::Bounds("0", "infinity"));
+            add_option<std::string>("statistics_file",
+                                    "File where the database statistics are written",
+                                    "\"dominance_statistics.jsonl\"");
         }
 
         virtual shared_ptr<DominancePruningPrevious> create_component(const plugins::Options &opts) const override {
 
             return plugins::make_shared_from_arg_tuples<DominancePruningPrevious>(
             opts.get<std::shared_ptr<DominanceDatabaseFactory>>("database"),
+                    opts.get<int>("statistics_interval"),
+                    opts.get<std::string>("statistics_file"),
                     get_dominance_pruning_arguments_from_options(opts));
         }
     };
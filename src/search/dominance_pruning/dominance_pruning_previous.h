@@ -6,31 +6,49 @@
 #include <unordered_set>
 #include <map>
 
+#include "database_statistics.h"
 #include "dominance_database.h"
 
 
 namespace dominance {
     class DominancePruningPrevious : public DominancePruning {
+        /*
+         * Buffers reused across operators and expansions, so that no memory is allocated per successor. succ and
+         * succ_transformed are equal to the parent except for the entries changed by the last operator.
+         */
+        ExplicitState parent_transformed;
+        ExplicitState succ;
+        ExplicitState succ_transformed;
+        ExplicitState updated_variables;
+        ExplicitState updated_factors;
+
+        // Undoes the changes of the last operator in succ and succ_transformed
+        void reset_successor(const ExplicitState & parent);
     public:
         std::shared_ptr<DominanceDatabaseFactory> database_factory;
         std::shared_ptr<DominanceDatabase> database;
+        // Snapshots of the database statistics are written every statistics_interval expansions (0 disables them)
+        int statistics_interval;
+        std::string statistics_file;
+        std::unique_ptr<DatabaseStatistics> statistics;
 
         DominancePruningPrevious(std::shared_ptr<DominanceDatabaseFactory> database_factory,
+                                int statistics_interval, const std::string &statistics_file,
                                 const std::shared_ptr<fts::FTSTaskFactory> & fts_factory,
                                 std::shared_ptr<DominanceAnalysis> dominance_analysis,
+                                std::shared_ptr<DominanceCache> cache,
                                 utils::Verbosity verbosity);
 
         virtual ~DominancePruningPrevious() = default;
 
         virtual void initialize(const std::shared_ptr<AbstractTask> &task) override;
         virtual void prune_generation(const State &state, const SearchNodeInfo &, std::vector<OperatorID> &op_ids) override;
-        virtual bool must_prune_operator(const OperatorProxy & op,
-                                 const State & state,
-                                 const ExplicitState & parent,
-                                 const ExplicitState & parent_transformed,
-                                 ExplicitState & succ,
-                                 ExplicitState & succ_transformed,
-                                 int g_value);
+        virtual void print_statistics() const override;
+        /*
+         * Applies op to the parent state, and transforms the successor into succ_transformed (both succ and
+         * succ_transformed must be equal to the parent). Returns true if the successor is dominated by the parent.
+         */
+        bool is_dominated_by_parent(const OperatorProxy & op, const State & state);
     };
 }
 
@@ -55,6 +55,21 @@ const EvaluationResult &EvaluationContext::get_result(Evaluator *evaluator) {
     return result;
 }
 
+bool EvaluationContext::has_result(Evaluator *evaluator) const {
+    return cache.contains(evaluator);
+}
+
+void EvaluationContext::set_result(Evaluator *evaluator, const EvaluationResult &new_result) {
+    EvaluationResult &result = cache[evaluator];
+    assert(result.is_uninitialized());
+    result = new_result;
+    if (statistics &&
+        evaluator->is_used_for_counting_evaluations() &&
+        result.get_count_evaluation()) {
+        statistics->inc_evaluations();
+    }
+}
+
 const EvaluatorCache &EvaluationContext::get_cache() const {
     return cache;
 }
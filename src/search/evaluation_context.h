@@ -89,6 +89,12 @@ public:
         SearchStatistics *statistics = nullptr, bool calculate_preferred = false);
 
     const EvaluationResult &get_result(Evaluator *eval);
+    bool has_result(Evaluator *eval) const;
+    /*
+      Store a result that was computed without calling get_result, e.g., by
+      Evaluator::compute_results for several contexts at once.
+    */
+    void set_result(Evaluator *eval, const EvaluationResult &result);
     const EvaluatorCache &get_cache() const;
     const State &get_state() const;
     int get_g_value() const;
@@ -6,6 +6,7 @@
 #include "utils/logging.h"
 
 #include <set>
+#include <vector>
 
 class EvaluationContext;
 class State;
@@ -82,6 +83,21 @@ public:
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) = 0;
 
+    /*
+      compute_results may compute the results for several evaluation
+      contexts at once (e.g., for all successors of a state) and store
+      them in the contexts, so that later calls to get_result do not
+      compute them again. Evaluators that can share work between the
+      states or evaluate them concurrently override this. The default
+      implementation does nothing, leaving the evaluation to get_result.
+    */
+    virtual void compute_results(
+        const std::vector<EvaluationContext *> &eval_contexts);
+    // Whether compute_results does any work, i.e., is worth collecting the contexts for.
+    virtual bool supports_batch_evaluation() const {
+        return false;
+    }
+
     void report_value_for_initial_state(const EvaluationResult &result) const;
     void report_new_minimum_value(const EvaluationResult &result) const;
 
@@ -6,6 +6,8 @@
 #include "../plugins/plugin.h"
 #include "../utils/component_errors.h"
 
+#include <algorithm>
+
 using namespace std;
 
 namespace combining_evaluator {
@@ -48,6 +50,20 @@ EvaluationResult CombiningEvaluator::compute_result(
     return result;
 }
 
+void CombiningEvaluator::compute_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    // The combined values are computed on demand from the stored results.
+    for (const shared_ptr<Evaluator> &subevaluator : subevaluators)
+        subevaluator->compute_results(eval_contexts);
+}
+
+bool CombiningEvaluator::supports_batch_evaluation() const {
+    return any_of(subevaluators.begin(), subevaluators.end(),
+                  [](const shared_ptr<Evaluator> &subevaluator) {
+                      return subevaluator->supports_batch_evaluation();
+                  });
+}
+
 void CombiningEvaluator::get_path_dependent_evaluators(
     set<Evaluator *> &evals) {
     for (auto &subevaluator : subevaluators)
@@ -36,6 +36,15 @@ EvaluationResult WeightedEvaluator::compute_result(
     return result;
 }
 
+void WeightedEvaluator::compute_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    evaluator->compute_results(eval_contexts);
+}
+
+bool WeightedEvaluator::supports_batch_evaluation() const {
+    return evaluator->supports_batch_evaluation();
+}
+
 void WeightedEvaluator::get_path_dependent_evaluators(set<Evaluator *> &evals) {
     evaluator->get_path_dependent_evaluators(evals);
 }
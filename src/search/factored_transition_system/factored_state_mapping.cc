@@ -2,42 +2,126 @@
 
 #include "../merge_and_shrink/merge_and_shrink_representation.h"
 #include "../merge_and_shrink/types.h"
+#include "../utils/binary_file.h"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
 
 namespace fts {
+    // Tags that identify the type of mapping in the binary serialization
+    static const uint8_t IDENTITY_TAG = 0;
+    static const uint8_t MERGE_AND_SHRINK_TAG = 1;
+
+    std::unique_ptr<FactoredStateMapping> FactoredStateMapping::load(utils::BinaryReader &reader) {
+        uint8_t tag = reader.read<uint8_t>();
+        if (tag == IDENTITY_TAG) {
+            return std::make_unique<FactoredStateMappingIdentity>();
+        } else if (tag == MERGE_AND_SHRINK_TAG) {
+            std::vector<std::unique_ptr<merge_and_shrink::MergeAndShrinkRepresentation>> factored_mapping(reader.read<uint64_t>());
+            for (auto &representation : factored_mapping) {
+                representation = merge_and_shrink::MergeAndShrinkRepresentation::load(reader);
+            }
+            std::vector<int> variable_to_factor = reader.read_vector<int>();
+            return std::make_unique<FactoredStateMappingMergeAndShrink>(std::move(factored_mapping), std::move(variable_to_factor));
+        }
+        throw utils::BinaryFileError("unknown factored state mapping");
+    }
+
+    void FactoredStateMappingIdentity::save(utils::BinaryWriter &writer) const {
+        writer.write(IDENTITY_TAG);
+    }
+
+    void FactoredStateMappingMergeAndShrink::save(utils::BinaryWriter &writer) const {
+        writer.write(MERGE_AND_SHRINK_TAG);
+        writer.write<uint64_t>(factored_mapping.size());
+        for (const auto &representation : factored_mapping) {
+            representation->save(writer);
+        }
+        writer.write_vector(variable_to_factor);
+    }
+
+    FactoredStateMappingMergeAndShrink::FactoredStateMappingMergeAndShrink(std::vector<std::unique_ptr<merge_and_shrink::MergeAndShrinkRepresentation>> &&factored_mapping,
+                                                                           std::vector<int> &&variable_to_factor) :
+        factored_mapping(std::move(factored_mapping)), variable_to_factor(std::move(variable_to_factor)) {
+        factor_begin.reserve(this->factored_mapping.size() + 1);
+        factor_begin.push_back(0);
+        for (const auto & representation : this->factored_mapping) {
+            representation->flatten(flat_mapping);
+            factor_begin.push_back(flat_mapping.nodes.size());
+        }
+        node_values.resize(flat_mapping.nodes.size());
+    }
+
+    int FactoredStateMappingMergeAndShrink::evaluate(int factor, const std::vector<int> &state) {
+        const auto & nodes = flat_mapping.nodes;
+        const auto & table = flat_mapping.table;
+        const int end = factor_begin[factor + 1];
+        for (int i = factor_begin[factor]; i < end; ++i) {
+            const auto & node = nodes[i];
+            if (node.var != -1) {
+                node_values[i] = table[node.offset + state[node.var]];
+            } else {
+                const int left = node_values[node.left_child];
+                const int right = node_values[node.right_child];
+                if (left == merge_and_shrink::PRUNED_STATE || right == merge_and_shrink::PRUNED_STATE) {
+                    node_values[i] = merge_and_shrink::PRUNED_STATE;
+                } else {
+                    node_values[i] = table[node.offset + left * node.stride + right];
+                }
+            }
+        }
+        return node_values[end - 1];
+    }
+
+    FactoredStateMappingMergeAndShrink::~FactoredStateMappingMergeAndShrink() = default;
+
     std::vector<int> FactoredStateMappingMergeAndShrink::transform(const std::vector<int> &state) {
         std::vector<int> result;
         result.reserve(factored_mapping.size());
-        for (const auto & f : factored_mapping) {
-            result.push_back(f->get_value(state));
+        for (int factor = 0; factor < static_cast<int>(factored_mapping.size()); ++factor) {
+            result.push_back(evaluate(factor, state));
         }
 
         return result;
     }
 
 
-    std::optional<std::vector<int>>
-    FactoredStateMappingMergeAndShrink::update_transformation_in_place(std::vector<int> &transformed_state_values,
-                                                                       const std::vector<int> &state_values,
-                                                                       std::vector<int> &updated_state_variables) {
-        std::vector<int> updated_factors;
-        for(int var : updated_state_variables) {
-            updated_factors.push_back(variable_to_factor[var]);
+    bool FactoredStateMappingMergeAndShrink::update_transformation_in_place(std::vector<int> &transformed_state_values,
+                                                                            const std::vector<int> &state_values,
+                                                                            const std::vector<int> &updated_state_variables,
+                                                                            std::vector<int> &updated_factors) {
+        updated_factors.clear();
+        for (int var : updated_state_variables) {
+            // Operators only change a few variables, so a linear search is cheaper than sorting
+            const int factor = variable_to_factor[var];
+            if (std::ranges::find(updated_factors, factor) == updated_factors.end()) {
+                updated_factors.push_back(factor);
+            }
         }
-        std::ranges::sort(updated_factors);
-        updated_factors.erase( std::unique(updated_factors.begin(), updated_factors.end()), updated_factors.end() );
 
         for (int factor : updated_factors) {
-            transformed_state_values[factor] = factored_mapping[factor]->get_value(state_values);
+            transformed_state_values[factor] = evaluate(factor, state_values);
             if (transformed_state_values[factor] == merge_and_shrink::PRUNED_STATE) {
-                return std::nullopt;
+                return false;
             }
         }
-
-        return {updated_factors};
+        return true;
     }
 
     int FactoredStateMappingMergeAndShrink::get_value(const std::vector<int> &state, int factor) {
-        return factored_mapping[factor]->get_value(state);
+        return evaluate(factor, state);
+    }
+
+    std::vector<std::vector<int>> FactoredStateMappingMergeAndShrink::get_variable_partitions(int num_variables) const {
+        assert(static_cast<int>(variable_to_factor.size()) == num_variables);
+        std::vector<std::vector<int>> partitions(factored_mapping.size() + 1);
+        for (int var = 0; var < num_variables; ++var) {
+            int factor = variable_to_factor[var];
+            partitions[factor == -1 ? factored_mapping.size() : factor].push_back(var);
+        }
+        std::erase_if(partitions, [](const std::vector<int> &partition) { return partition.empty(); });
+        return partitions;
     }
 
     // TODO (efficiency): Can we avoid copying the state here?
@@ -45,17 +129,24 @@ namespace fts {
         return state;
     }
 
-    std::optional<std::vector<int>>
-    FactoredStateMappingIdentity::update_transformation_in_place(std::vector<int> &transformed_state_values,
-                                                                 const std::vector<int> &state_values,
-                                                                 std::vector<int> &updated_state_variables) {
+    bool FactoredStateMappingIdentity::update_transformation_in_place(std::vector<int> &transformed_state_values,
+                                                                      const std::vector<int> &state_values,
+                                                                      const std::vector<int> &updated_state_variables,
+                                                                      std::vector<int> &updated_factors) {
+        updated_factors.assign(updated_state_variables.begin(), updated_state_variables.end());
         for (int var: updated_state_variables) {
             transformed_state_values[var] = state_values[var];
         }
-        return {updated_state_variables};
+        return true;
     }
 
     int FactoredStateMappingIdentity::get_value(const std::vector<int> &state, int factor) {
         return state[factor];
     }
+
+    std::vector<std::vector<int>> FactoredStateMappingIdentity::get_variable_partitions(int num_variables) const {
+        std::vector<int> variables(num_variables);
+        std::iota(variables.begin(), variables.end(), 0);
+        return {variables};
+    }
 }
\ No newline at end of file
@@ -6,24 +6,44 @@
 #include <optional>
 
 #include "../task_proxy.h"
+#include "../merge_and_shrink/merge_and_shrink_representation.h"
 
-namespace merge_and_shrink {
-    class MergeAndShrinkRepresentation;
+class State;
+
+namespace utils {
+    class BinaryReader;
+    class BinaryWriter;
 }
 
-class State;
 namespace fts {
     class FactoredStateMapping {
         public:
             virtual ~FactoredStateMapping() = default;
 
+            // Binary serialization, read back with load
+            virtual void save(utils::BinaryWriter &writer) const = 0;
+            static std::unique_ptr<FactoredStateMapping> load(utils::BinaryReader &reader);
+
             virtual int get_value(const std::vector<int> & state, int factor) = 0;
 
             virtual std::vector<int> transform(const std::vector<int> & state) = 0;
 
-            virtual std::optional<std::vector<int>> update_transformation_in_place(std::vector<int> & transformed_state_values,
-                                                                    const std::vector<int> & state_values,
-                                                                    std::vector<int> & updated_state_variables)  = 0;
+            /*
+             * Updates transformed_state_values after the variables in updated_state_variables changed in
+             * state_values. The factors that were recomputed are written to updated_factors, which is owned by the
+             * caller so that its memory is reused across calls. Returns false if the new state is pruned.
+             */
+            virtual bool update_transformation_in_place(std::vector<int> & transformed_state_values,
+                                                        const std::vector<int> & state_values,
+                                                        const std::vector<int> & updated_state_variables,
+                                                        std::vector<int> & updated_factors) = 0;
+
+            /*
+             * Groups the variables of the task by the factor they are mapped to, in the order of the factors. The
+             * variables that are not mapped to any factor are in the last group. Used to keep the variables of
+             * each factor contiguous in a variable ordering.
+             */
+            virtual std::vector<std::vector<int>> get_variable_partitions(int num_variables) const = 0;
     };
 
     class FactoredStateMappingIdentity : public FactoredStateMapping {
@@ -31,22 +51,46 @@ namespace fts {
         int get_value(const std::vector<int> & state, int factor) override;
         std::vector<int> transform(const std::vector<int> & state) override;
 
-        std::optional<std::vector<int>> update_transformation_in_place(std::vector<int> & transformed_state_values,
-                                                        const std::vector<int> & state_values,
-                                                        std::vector<int> & updated_state_variables) override;
+        bool update_transformation_in_place(std::vector<int> & transformed_state_values,
+                                            const std::vector<int> & state_values,
+                                            const std::vector<int> & updated_state_variables,
+                                            std::vector<int> & updated_factors) override;
+
+        std::vector<std::vector<int>> get_variable_partitions(int num_variables) const override;
+
+        void save(utils::BinaryWriter &writer) const override;
     };
 
     class FactoredStateMappingMergeAndShrink : public FactoredStateMapping {
         std::vector<std::unique_ptr<merge_and_shrink::MergeAndShrinkRepresentation>> factored_mapping;
         std::vector<int> variable_to_factor;
 
+        /*
+         * The representations of all factors flattened into one table, which is what is used to evaluate them.
+         * The nodes of factor f are in [factor_begin[f], factor_begin[f + 1]), its root being the last one.
+         */
+        merge_and_shrink::FlatMergeAndShrinkRepresentation flat_mapping;
+        std::vector<int> factor_begin;
+        // Value of each node in the last evaluation
+        std::vector<int> node_values;
+
+        int evaluate(int factor, const std::vector<int> & state);
     public:
+        FactoredStateMappingMergeAndShrink(std::vector<std::unique_ptr<merge_and_shrink::MergeAndShrinkRepresentation>> && factored_mapping,
+                                           std::vector<int> && variable_to_factor);
+        ~FactoredStateMappingMergeAndShrink() override;
+
         int get_value(const std::vector<int> & state, int factor) override;
         std::vector<int> transform(const std::vector<int> & state) override;
 
-        std::optional<std::vector<int>> update_transformation_in_place(std::vector<int> & transformed_state_values,
-                                                        const std::vector<int> & state_values,
-                                                        std::vector<int> & updated_state_variables) override;
+        bool update_transformation_in_place(std::vector<int> & transformed_state_values,
+                                            const std::vector<int> & state_values,
+                                            const std::vector<int> & updated_state_variables,
+                                            std::vector<int> & updated_factors) override;
+
+        std::vector<std::vector<int>> get_variable_partitions(int num_variables) const override;
+
+        void save(utils::BinaryWriter &writer) const override;
 
         const auto & get_mapping() const {
             return factored_mapping;
@@ -3,6 +3,7 @@
 #include <cassert>
 
 #include "fact_names.h"
+#include "../utils/binary_file.h"
 #include "../utils/system.h"
 #include "labelled_transition_system.h"
 #include "../merge_and_shrink/factored_transition_system.h"
@@ -39,6 +40,26 @@ namespace fts {
         }
     }
 
+    FTSTask::FTSTask(utils::BinaryReader &reader, const std::shared_ptr<AbstractTask>& parent)
+    : fact_names(std::make_shared<AbstractTaskFactNames>(parent)) {
+        label_costs = reader.read_vector<int>();
+        const auto num_factors = reader.read<uint64_t>();
+        for (uint64_t ts = 0; ts < num_factors; ++ts) {
+            transition_systems.push_back(std::make_unique<LabelledTransitionSystem>(reader, get_debug_or_release_fact_value_names(fact_names, ts)));
+            if (transition_systems.back()->get_num_labels() != get_num_labels()) {
+                throw utils::BinaryFileError("wrong number of labels");
+            }
+        }
+    }
+
+    void FTSTask::save(utils::BinaryWriter &writer) const {
+        writer.write_vector(label_costs);
+        writer.write<uint64_t>(transition_systems.size());
+        for (const auto & ts : transition_systems) {
+            ts->save(writer);
+        }
+    }
+
     int FTSTask::get_num_labels() const {
         return label_costs.size();
     }
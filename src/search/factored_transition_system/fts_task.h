@@ -11,6 +11,11 @@ namespace merge_and_shrink {
     class FactoredTransitionSystem;
 }
 
+namespace utils {
+    class BinaryReader;
+    class BinaryWriter;
+}
+
 namespace fts {
     class FactNames;
     // This is very similar to the merge_and_shrink::FactoredTransitionSystem
@@ -35,6 +40,10 @@ namespace fts {
     public:
         FTSTask(const merge_and_shrink::FactoredTransitionSystem & fts);
         FTSTask(const merge_and_shrink::FactoredTransitionSystem & fts, const std::shared_ptr<AbstractTask>& parent);
+        // Reads a task written with save. Fact and action names are taken from the parent task.
+        FTSTask(utils::BinaryReader &reader, const std::shared_ptr<AbstractTask>& parent);
+
+        void save(utils::BinaryWriter &writer) const;
 
 
         int get_num_labels() const;
@@ -3,8 +3,16 @@
 #include "fts_task.h"
 #include "factored_state_mapping.h"
 #include "labelled_transition_system.h"
+#include "../merge_and_shrink/distances.h"
 #include "../merge_and_shrink/fts_factory.h"
 #include "../merge_and_shrink/factored_transition_system.h"
+#include "../merge_and_shrink/merge_and_shrink_algorithm.h"
+#include "../merge_and_shrink/merge_and_shrink_representation.h"
+#include "../merge_and_shrink/merge_strategy_factory.h"
+#include "../merge_and_shrink/shrink_strategy.h"
+#include "../merge_and_shrink/label_reduction.h"
+#include "../merge_and_shrink/transition_system.h"
+#include "../merge_and_shrink/types.h"
 
 #include "../plugins/plugin.h"
 
@@ -44,8 +52,10 @@ namespace fts {
             document_title("Constructs atomic transition systems");
         }
 
-        virtual std::shared_ptr<AtomicTaskFactory> create_component(const plugins::Options &) const override {
-            return plugins::make_shared_from_arg_tuples<AtomicTaskFactory>();
+        virtual std::shared_ptr<AtomicTaskFactory> create_component(const plugins::Options &opts) const override {
+            auto factory = plugins::make_shared_from_arg_tuples<AtomicTaskFactory>();
+            factory->set_config(opts.get_unparsed_config());
+            return factory;
         }
     };
 
@@ -53,5 +63,142 @@ namespace fts {
 
 static plugins::FeaturePlugin<AtomicTaskFactoryFeature> _plugin_atomic;
 
-    //TODO: Plugin and implementation for MergeAndShrinkTaskFactory
+    MergeAndShrinkTaskFactory::MergeAndShrinkTaskFactory(const std::shared_ptr<merge_and_shrink::MergeStrategyFactory> &merge_strategy,
+                                                         const std::shared_ptr<merge_and_shrink::ShrinkStrategy> &shrink_strategy,
+                                                         const std::shared_ptr<merge_and_shrink::LabelReduction> &label_reduction,
+                                                         bool prune_unreachable_states, bool prune_irrelevant_states,
+                                                         int max_states, int max_states_before_merge, int threshold_before_merge,
+                                                         double main_loop_max_time, int max_total_states, utils::Verbosity verbosity) :
+        merge_strategy(merge_strategy), shrink_strategy(shrink_strategy), label_reduction(label_reduction),
+        prune_unreachable_states(prune_unreachable_states), prune_irrelevant_states(prune_irrelevant_states),
+        max_states(max_states), max_states_before_merge(max_states_before_merge), threshold_before_merge(threshold_before_merge),
+        main_loop_max_time(main_loop_max_time), max_total_states(max_total_states), verbosity(verbosity),
+        log(utils::get_log_for_verbosity(verbosity)) {
+        if (log.is_warning() && (!shrink_strategy->preserves_bisimulation() ||
+                                 max_states != merge_and_shrink::INF ||
+                                 max_states_before_merge != merge_and_shrink::INF)) {
+            log << "WARNING: the merge_and_shrink FTS task factory may shrink factors beyond a bisimulation, "
+                << "so dominance relations computed on the resulting FTS task may not be sound" << std::endl;
+        }
+    }
+
+    TransformedFTSTask MergeAndShrinkTaskFactory::transform_to_fts(const std::shared_ptr<AbstractTask> &task) {
+        TaskProxy task_proxy (*task);
+        // The algorithm can only be run once, so we create a new one for each task
+        merge_and_shrink::MergeAndShrinkAlgorithm algorithm(merge_strategy, shrink_strategy, label_reduction,
+                                                            prune_unreachable_states, prune_irrelevant_states,
+                                                            max_states, max_states_before_merge, threshold_before_merge,
+                                                            main_loop_max_time, verbosity, max_total_states);
+        merge_and_shrink::FactoredTransitionSystem fts = algorithm.build_factored_transition_system(task_proxy);
+
+        auto fts_task = std::make_unique<FTSTask>(fts, task);
+
+        // The factors of the FTSTask are the active factors of the FTS, in the same order
+        std::vector<int> active_factors;
+        for (int index : fts) {
+            active_factors.push_back(index);
+        }
+        std::vector<int> variable_to_factor(task_proxy.get_variables().size(), -1);
+        std::vector<std::unique_ptr<merge_and_shrink::MergeAndShrinkRepresentation>> factored_mapping;
+        for (size_t factor = 0; factor < active_factors.size(); ++factor) {
+            for (int var : fts.get_transition_system(active_factors[factor]).get_incorporated_variables()) {
+                variable_to_factor[var] = factor;
+            }
+        }
+        for (int index : active_factors) {
+            factored_mapping.push_back(fts.extract_factor(index).first);
+        }
+
+        if (log.is_at_least_normal()) {
+            log << "Merge-and-shrink FTS task with " << fts_task->get_num_variables() << " factors and "
+                << fts_task->get_num_labels() << " labels" << std::endl;
+        }
+
+        return {std::move(fts_task),
+                std::make_unique<FactoredStateMappingMergeAndShrink>(std::move(factored_mapping), std::move(variable_to_factor))};
+    }
+
+    class MergeAndShrinkTaskFactoryFeature
+            : public plugins::TypedFeature<FTSTaskFactory, MergeAndShrinkTaskFactory> {
+    public:
+        MergeAndShrinkTaskFactoryFeature() : TypedFeature("merge_and_shrink") {
+            document_title("Constructs transition systems with merge-and-shrink");
+            document_synopsis(
+                    "Runs the merge-and-shrink algorithm and uses the resulting factors as the FTS task. Larger factors "
+                    "usually result in stronger dominance relations, at the cost of a more expensive computation of "
+                    "the relation. The main loop can be stopped with main_loop_max_time or max_total_states, which "
+                    "leaves several factors. The dominance relation is only sound if all factors are "
+                    "bisimulations, which is the case with the default options. Finite transition system size "
+                    "limits, or shrink strategies other than non-greedy bisimulation, may result in dominance "
+                    "relations that are not sound for the original task.");
+
+            add_option<std::shared_ptr<merge_and_shrink::MergeStrategyFactory>>(
+                    "merge_strategy",
+                    "See detailed documentation for merge strategies.",
+                    "merge_sccs(order_of_sccs=topological,merge_selector=score_based_filtering("
+                    "scoring_functions=[goal_relevance(),dfp(),total_order()]))");
+            add_option<std::shared_ptr<merge_and_shrink::ShrinkStrategy>>(
+                    "shrink_strategy",
+                    "See detailed documentation for shrink strategies.",
+                    "shrink_bisimulation(greedy=false)");
+            add_option<std::shared_ptr<merge_and_shrink::LabelReduction>>(
+                    "label_reduction",
+                    "See detailed documentation for labels.",
+                    plugins::ArgumentInfo::NO_DEFAULT);
+            add_option<bool>(
+                    "prune_unreachable_states",
+                    "If true, prune abstract states unreachable from the initial state.",
+                    "true");
+            add_option<bool>(
+                    "prune_irrelevant_states",
+                    "If true, prune abstract states from which no goal state can be reached.",
+                    "true");
+            add_option<int>(
+                    "max_states",
+                    "maximum transition system size allowed at any time point.",
+                    "infinity",
+                    plugins::Bounds("1", "infinity"));
+            add_option<int>(
+                    "max_states_before_merge",
+                    "maximum transition system size allowed for two transition systems before being merged to form "
+                    "the synchronized product.",
+                    "infinity",
+                    plugins::Bounds("1", "infinity"));
+            add_option<int>(
+                    "threshold_before_merge",
+                    "If a transition system, before being merged, surpasses this soft transition system size limit, "
+                    "the shrink strategy is called to possibly shrink the transition system. The default shrinks "
+                    "every factor to its coarsest bisimulation before merging.",
+                    "1",
+                    plugins::Bounds("1", "infinity"));
+            add_option<double>(
+                    "main_loop_max_time",
+                    "A limit in seconds on the runtime of the main loop of the algorithm.",
+                    "infinity",
+                    plugins::Bounds("0.0", "infinity"));
+            add_option<int>(
+                    "max_total_states",
+                    "Stop merging when the sum of the sizes of all factors would exceed this limit after a merge.",
+                    "infinity",
+                    plugins::Bounds("1", "infinity"));
+            utils::add_log_options_to_feature(*this);
+        }
+
+        virtual std::shared_ptr<MergeAndShrinkTaskFactory> create_component(const plugins::Options &opts) const override {
+            auto factory = plugins::make_shared_from_arg_tuples<MergeAndShrinkTaskFactory>(
+                    opts.get<std::shared_ptr<merge_and_shrink::MergeStrategyFactory>>("merge_strategy"),
+                    opts.get<std::shared_ptr<merge_and_shrink::ShrinkStrategy>>("shrink_strategy"),
+                    opts.get<std::shared_ptr<merge_and_shrink::LabelReduction>>("label_reduction", nullptr),
+                    opts.get<bool>("prune_unreachable_states"),
+                    opts.get<bool>("prune_irrelevant_states"),
+                    merge_and_shrink::get_transition_system_size_limit_arguments_from_options(opts),
+                    opts.get<double>("main_loop_max_time"),
+                    opts.get<int>("max_total_states"),
+                    utils::get_log_arguments_from_options(opts));
+            factory->set_config(opts.get_unparsed_config());
+            return factory;
+        }
+    };
+
+    static plugins::FeaturePlugin<MergeAndShrinkTaskFactoryFeature> _plugin_merge_and_shrink;
 }
\ No newline at end of file
@@ -2,10 +2,18 @@
 #define FTS_FTS_TASK_FACTORY_H
 
 #include <memory>
+#include <string>
 #include "fts_task.h"
 #include "factored_state_mapping.h"
+#include "../utils/logging.h"
 class AbstractTask;
 
+namespace merge_and_shrink {
+    class LabelReduction;
+    class MergeStrategyFactory;
+    class ShrinkStrategy;
+}
+
 namespace fts {
     // Class to be used as return type
     struct TransformedFTSTask {
@@ -18,10 +26,20 @@ namespace fts {
     };
 
     class FTSTaskFactory {
+        // Configuration string of the component, which identifies its results in the DominanceCache
+        std::string config;
     protected:
         virtual ~FTSTaskFactory() = default;
     public:
         virtual TransformedFTSTask transform_to_fts(const std::shared_ptr<AbstractTask> & task) = 0;
+
+        void set_config(const std::string &config_) {
+            config = config_;
+        }
+
+        const std::string &get_config() const {
+            return config;
+        }
     };
 
     class AtomicTaskFactory : public FTSTaskFactory {
@@ -29,10 +47,38 @@ namespace fts {
         virtual TransformedFTSTask transform_to_fts(const std::shared_ptr<AbstractTask> & task) override;
     };
 
-/* TODO:    class MergeAndShrinkTaskFactory : public FTSTaskFactory {
+/*
+ * Builds the FTS with the merge-and-shrink algorithm, and maps the states of the task to the factors with the
+ * merge-and-shrink representations. The main loop of the algorithm can be stopped early with a time limit or a
+ * limit on the total number of states, so that the FTS may contain several factors.
+ *
+ * Dominance relations computed on the FTS are only sound if every factor is a bisimulation of the product of its
+ * variables, so by default the transition system size limits are infinite and factors are shrunk only with
+ * non-greedy bisimulation.
+ */
+    class MergeAndShrinkTaskFactory : public FTSTaskFactory {
+        std::shared_ptr<merge_and_shrink::MergeStrategyFactory> merge_strategy;
+        std::shared_ptr<merge_and_shrink::ShrinkStrategy> shrink_strategy;
+        std::shared_ptr<merge_and_shrink::LabelReduction> label_reduction;
+        bool prune_unreachable_states;
+        bool prune_irrelevant_states;
+        int max_states;
+        int max_states_before_merge;
+        int threshold_before_merge;
+        double main_loop_max_time;
+        int max_total_states;
+        utils::Verbosity verbosity;
+        mutable utils::LogProxy log;
     public:
+        MergeAndShrinkTaskFactory(const std::shared_ptr<merge_and_shrink::MergeStrategyFactory> &merge_strategy,
+                                  const std::shared_ptr<merge_and_shrink::ShrinkStrategy> &shrink_strategy,
+                                  const std::shared_ptr<merge_and_shrink::LabelReduction> &label_reduction,
+                                  bool prune_unreachable_states, bool prune_irrelevant_states,
+                                  int max_states, int max_states_before_merge, int threshold_before_merge,
+                                  double main_loop_max_time, int max_total_states, utils::Verbosity verbosity);
+
         virtual TransformedFTSTask transform_to_fts(const std::shared_ptr<AbstractTask> & task) override;
-    };*/
+    };
 }
 
 #endif
@@ -5,6 +5,7 @@
 #include "fact_names.h"
 #include "label_map.h"
 #include "../merge_and_shrink/transition_system.h"
+#include "../utils/binary_file.h"
 
 class AbstractTask;
 using namespace std;
@@ -18,6 +19,7 @@ namespace fts {
         label_group_of_label.resize(num_labels, LabelGroup(-1));
 
         transitions_src.resize(num_states);
+        transitions_tgt.resize(num_states);
 
         for (const auto & local_label_info : ts) {
             const auto & abs_tr = local_label_info.get_transitions();
@@ -41,6 +43,7 @@ namespace fts {
                     transitions_label_group[new_label_group_id.group].push_back(TSTransition(tr.src, tr.target));
                     transitions.push_back(LTSTransition(tr.src, tr.target, new_label_group_id));
                     transitions_src[tr.src].push_back(LTSTransition(tr.src, tr.target, new_label_group_id));
+                    transitions_tgt[tr.target].push_back(LTSTransition(tr.src, tr.target, new_label_group_id));
                 }
             } else {
                 // Dead labels should have been removed
@@ -48,6 +51,73 @@ namespace fts {
             }
         }
 
+        build_label_group_source_index();
+        compute_relevant_label_groups();
+    }
+
+    LabelledTransitionSystem::LabelledTransitionSystem(utils::BinaryReader &reader,
+                                                       std::shared_ptr<FactValueNames> fact_value_names) :
+            num_states(reader.read<int>()), num_labels(reader.read<int>()), goal_states(reader.read_bool_vector()),
+            init_state(reader.read<int>()), goal_distances(reader.read_vector<int>()),
+            fact_value_names(std::move(fact_value_names)) {
+        label_groups.resize(reader.read<uint64_t>());
+        for (auto &label_group : label_groups) {
+            label_group = reader.read_vector<int>();
+        }
+        for (int group : reader.read_vector<int>()) {
+            label_group_of_label.emplace_back(group);
+        }
+        if (static_cast<int>(label_group_of_label.size()) != num_labels) {
+            throw utils::BinaryFileError("wrong number of labels");
+        }
+
+        // Transitions as triples (src, target, label group), in the same order as in the original LTS
+        const std::vector<int> flat_transitions = reader.read_vector<int>();
+        transitions_src.resize(num_states);
+        transitions_tgt.resize(num_states);
+        transitions_label_group.resize(label_groups.size());
+        transitions.reserve(flat_transitions.size() / 3);
+        for (size_t i = 0; i + 2 < flat_transitions.size(); i += 3) {
+            const LTSTransition tr(flat_transitions[i], flat_transitions[i + 1], LabelGroup(flat_transitions[i + 2]));
+            if (tr.src < 0 || tr.src >= num_states || tr.target < 0 || tr.target >= num_states ||
+                tr.label_group.group < 0 || tr.label_group.group >= static_cast<int>(label_groups.size())) {
+                throw utils::BinaryFileError("transition out of range");
+            }
+            transitions_label_group[tr.label_group.group].push_back(TSTransition(tr.src, tr.target));
+            transitions.push_back(tr);
+            transitions_src[tr.src].push_back(tr);
+            transitions_tgt[tr.target].push_back(tr);
+        }
+
+        build_label_group_source_index();
+        compute_relevant_label_groups();
+    }
+
+    void LabelledTransitionSystem::save(utils::BinaryWriter &writer) const {
+        writer.write(num_states);
+        writer.write(num_labels);
+        writer.write_vector(goal_states);
+        writer.write(init_state);
+        writer.write_vector(goal_distances);
+        writer.write<uint64_t>(label_groups.size());
+        for (const auto &label_group : label_groups) {
+            writer.write_vector(label_group);
+        }
+        std::vector<int> groups;
+        groups.reserve(label_group_of_label.size());
+        for (LabelGroup lg : label_group_of_label) {
+            groups.push_back(lg.group);
+        }
+        writer.write_vector(groups);
+        std::vector<int> flat_transitions;
+        flat_transitions.reserve(3 * transitions.size());
+        for (const LTSTransition &tr : transitions) {
+            flat_transitions.insert(flat_transitions.end(), {tr.src, tr.target, tr.label_group.group});
+        }
+        writer.write_vector(flat_transitions);
+    }
+
+    void LabelledTransitionSystem::compute_relevant_label_groups() {
         label_group_is_relevant.resize(label_groups.size(), false);
         for (const auto& [lg_i, _] : std::views::enumerate(label_groups)) {
             if (const auto lg = LabelGroup(static_cast<int>(lg_i)); !irrelevant_label_group(lg)) {
@@ -57,6 +127,31 @@ namespace fts {
         }
     }
 
+    void LabelledTransitionSystem::build_label_group_source_index() {
+        std::vector<LTSTransition> sorted_transitions = transitions;
+        std::ranges::sort(sorted_transitions, [](const LTSTransition &a, const LTSTransition &b) {
+            if (a.src != b.src) return a.src < b.src;
+            if (a.label_group != b.label_group) return a.label_group < b.label_group;
+            return a.target < b.target;
+        });
+
+        src_label_group_begin.assign(num_states + 1, 0);
+        src_label_group_targets.reserve(sorted_transitions.size());
+        for (size_t i = 0; i < sorted_transitions.size(); ++i) {
+            const LTSTransition &tr = sorted_transitions[i];
+            if (i == 0 || tr.src != sorted_transitions[i - 1].src || tr.label_group != sorted_transitions[i - 1].label_group) {
+                src_label_groups.push_back(tr.label_group);
+                src_label_group_target_begin.push_back(src_label_group_targets.size());
+                ++src_label_group_begin[tr.src + 1];
+            }
+            src_label_group_targets.push_back(tr.target);
+        }
+        src_label_group_target_begin.push_back(src_label_group_targets.size());
+        for (int s = 0; s < num_states; ++s) {
+            src_label_group_begin[s + 1] += src_label_group_begin[s];
+        }
+    }
+
     std::string LabelledTransitionSystem::state_name(int s) const {
         return fact_value_names->get_fact_value_name(s);
     }
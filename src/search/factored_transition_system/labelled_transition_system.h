@@ -10,6 +10,7 @@
 #include <generator>
 #include <ranges>
 #include <memory>
+#include <span>
 
 class AbstractTask;
 
@@ -17,6 +18,11 @@ namespace merge_and_shrink {
     class TransitionSystem;
 }
 
+namespace utils {
+    class BinaryReader;
+    class BinaryWriter;
+}
+
 namespace fts {
     class FactValueNames;
     typedef int AbstractStateRef;
@@ -132,14 +138,29 @@ namespace fts {
         std::vector<LabelGroup> label_group_of_label; //TODO: Make a map to avoid representing irrelevant labels explicitly?
         std::vector<LTSTransition> transitions;
         std::vector<std::vector<LTSTransition> > transitions_src;
+        std::vector<std::vector<LTSTransition> > transitions_tgt;
         std::vector<std::vector<TSTransition> > transitions_label_group;
 
+        // Transitions indexed by source and label group (CSR). The label groups with transitions from s are
+        // src_label_groups[src_label_group_begin[s] .. src_label_group_begin[s + 1]) in increasing order, and the
+        // targets of the i-th of them are src_label_group_targets[src_label_group_target_begin[i] .. src_label_group_target_begin[i + 1]).
+        std::vector<int> src_label_group_begin;
+        std::vector<LabelGroup> src_label_groups;
+        std::vector<int> src_label_group_target_begin;
+        std::vector<AbstractStateRef> src_label_group_targets;
+
+        void build_label_group_source_index();
+        void compute_relevant_label_groups();
 
         bool is_self_loop_everywhere_label_group(LabelGroup lg) const;
 
     public:
         std::shared_ptr<FactValueNames> fact_value_names;
         LabelledTransitionSystem(const merge_and_shrink::TransitionSystem &abs, const LabelMap &labelMap, std::shared_ptr<FactValueNames> fact_value_names);
+        // Reads a LTS written with save. The redundant representations of the transitions are rebuilt.
+        LabelledTransitionSystem(utils::BinaryReader &reader, std::shared_ptr<FactValueNames> fact_value_names);
+
+        void save(utils::BinaryWriter &writer) const;
 
         ~LabelledTransitionSystem() {}
 
@@ -171,6 +192,10 @@ namespace fts {
             return transitions_src[sfrom];
         }
 
+        const std::vector<LTSTransition> &get_transitions_to(int sto) const {
+            return transitions_tgt[sto];
+        }
+
         const std::vector<TSTransition> &get_transitions_label(int label) const {
             return transitions_label_group[label_group_of_label[label].group];
         }
@@ -210,6 +235,30 @@ namespace fts {
             return false;
         }
 
+        // Targets of the transitions src--lg-->t, sorted
+        std::span<const AbstractStateRef> get_targets(LabelGroup label_group, AbstractStateRef src) const {
+            auto first = src_label_groups.begin() + src_label_group_begin[src];
+            auto last = src_label_groups.begin() + src_label_group_begin[src + 1];
+            auto it = std::lower_bound(first, last, label_group);
+            if (it == last || *it != label_group) {
+                return {};
+            }
+            size_t i = it - src_label_groups.begin();
+            return {src_label_group_targets.data() + src_label_group_target_begin[i],
+                    static_cast<size_t>(src_label_group_target_begin[i + 1] - src_label_group_target_begin[i])};
+        }
+
+        //For each label group with transitions from src, apply a function to the group and its targets. If returns true, applies a break
+        bool applyPostSrcGrouped(int from,
+                                 std::function<bool(LabelGroup label_group, std::span<const AbstractStateRef> targets)> &&f) const {
+            for (int i = src_label_group_begin[from]; i < src_label_group_begin[from + 1]; ++i) {
+                std::span<const AbstractStateRef> targets(src_label_group_targets.data() + src_label_group_target_begin[i],
+                                                          src_label_group_target_begin[i + 1] - src_label_group_target_begin[i]);
+                if (f(src_label_groups[i], targets)) return true;
+            }
+            return false;
+        }
+
         [[nodiscard]] const std::vector<std::vector<int>>& get_label_groups() const {
             return label_groups;
         }
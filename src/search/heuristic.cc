@@ -108,6 +108,53 @@ EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
     return result;
 }
 
+void Heuristic::compute_heuristics(
+    const vector<EvaluationContext *> &eval_contexts, vector<int> &heuristics) {
+    heuristics.clear();
+    for (EvaluationContext *eval_context : eval_contexts) {
+        heuristics.push_back(compute_heuristic(eval_context->get_state()));
+        // Preferred operators are not computed in batches.
+        preferred_operators.clear();
+    }
+}
+
+void Heuristic::compute_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    if (!supports_batch_evaluation()) {
+        return;
+    }
+
+    vector<EvaluationContext *> uncached_contexts;
+    for (EvaluationContext *eval_context : eval_contexts) {
+        const State &state = eval_context->get_state();
+        if (eval_context->has_result(this) ||
+            eval_context->get_calculate_preferred() ||
+            (cache_evaluator_values && heuristic_cache[state].h != NO_VALUE &&
+             !heuristic_cache[state].dirty)) {
+            continue;
+        }
+        uncached_contexts.push_back(eval_context);
+    }
+    if (uncached_contexts.empty()) {
+        return;
+    }
+
+    vector<int> heuristics;
+    compute_heuristics(uncached_contexts, heuristics);
+    assert(heuristics.size() == uncached_contexts.size());
+    for (size_t i = 0; i < uncached_contexts.size(); ++i) {
+        int heuristic = heuristics[i];
+        assert(heuristic == DEAD_END || heuristic >= 0);
+        if (cache_evaluator_values) {
+            heuristic_cache[uncached_contexts[i]->get_state()] = HEntry(heuristic, false);
+        }
+        EvaluationResult result;
+        result.set_count_evaluation(true);
+        result.set_evaluator_value(heuristic == DEAD_END ? EvaluationResult::INFTY : heuristic);
+        uncached_contexts[i]->set_result(this, result);
+    }
+}
+
 bool Heuristic::does_cache_estimates() const {
     return cache_evaluator_values;
 }
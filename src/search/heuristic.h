@@ -63,6 +63,17 @@ protected:
 
     virtual int compute_heuristic(const State &ancestor_state) = 0;
 
+    /*
+      Compute the heuristic values of the states of several evaluation
+      contexts at once. This is only used if supports_batch_evaluation
+      returns true, for heuristics that can evaluate several states more
+      efficiently together, e.g., concurrently. The default implementation
+      calls compute_heuristic for each state.
+    */
+    virtual void compute_heuristics(
+        const std::vector<EvaluationContext *> &eval_contexts,
+        std::vector<int> &heuristics);
+
     /*
       Usage note: Marking the same operator as preferred multiple times
       is OK -- it will only appear once in the list of preferred
@@ -85,6 +96,8 @@ public:
 
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) override;
+    virtual void compute_results(
+        const std::vector<EvaluationContext *> &eval_contexts) override;
 
     virtual bool does_cache_estimates() const override;
     virtual bool is_estimate_cached(const State &state) const override;
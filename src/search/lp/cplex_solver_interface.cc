@@ -403,6 +403,15 @@ void CplexSolverInterface::add_temporary_constraints(
     }
 }
 
+void CplexSolverInterface::add_permanent_constraints(
+    const named_vector::NamedVector<LPConstraint> &constraints) {
+    assert(!has_temporary_constraints());
+    add_temporary_constraints(constraints);
+    num_permanent_constraints = get_num_constraints();
+    num_unsatisfiable_constraints += num_unsatisfiable_temp_constraints;
+    num_unsatisfiable_temp_constraints = 0;
+}
+
 void CplexSolverInterface::clear_temporary_constraints() {
     int start = num_permanent_constraints;
     int end = get_num_constraints() - 1;
@@ -438,6 +447,14 @@ void CplexSolverInterface::set_constraint_upper_bound(int index, double bound) {
     change_constraint_bounds(index, constraint_lower_bounds[index], bound);
 }
 
+void CplexSolverInterface::set_constraint_coefficients(
+    int index, const vector<int> &variables, const vector<double> &coefficients) {
+    assert(variables.size() == coefficients.size());
+    vector<int> row_list(variables.size(), index);
+    CPX_CALL(CPXchgcoeflist, env, problem, variables.size(),
+             row_list.data(), variables.data(), coefficients.data());
+}
+
 void CplexSolverInterface::set_variable_lower_bound(int index, double bound) {
     static const char bound_type = 'L';
     CPX_CALL(CPXchgbds, env, problem, 1, &index, &bound_type, &bound);
@@ -8,6 +8,11 @@
 #endif
 
 #include "../plugins/plugin.h"
+#include "../utils/hash.h"
+
+#include <algorithm>
+#include <cassert>
+#include <list>
 
 using namespace std;
 
@@ -117,6 +122,116 @@ void LinearProgram::set_objective_name(const string &name) {
 }
 
 
+/*
+  Temporary constraints that stay in the LP as permanent rows. A pooled
+  constraint is active if it was added for the current evaluation, and relaxed
+  to a free row otherwise. Once the pool is full, the row of the inactive
+  constraint that was used least recently is reused for a new constraint.
+*/
+class ConstraintPool {
+    // Pooled constraints with the given variables (in the order of insertion)
+    utils::HashMap<vector<int>, vector<int>> constraints_by_variables;
+    vector<vector<int>> variables;
+    vector<vector<double>> coefficients;
+    // Inactive constraints, least recently used first
+    list<int> inactive;
+    vector<list<int>::iterator> position_in_inactive;
+public:
+    const int max_size;
+    vector<int> rows;
+    vector<double> lower_bounds;
+    vector<double> upper_bounds;
+    vector<bool> is_active;
+    vector<int> active;
+
+    explicit ConstraintPool(int max_size)
+        : max_size(max_size) {
+    }
+
+    int size() const {
+        return rows.size();
+    }
+
+    int find(const LPConstraint &constraint) const {
+        auto it = constraints_by_variables.find(constraint.get_variables());
+        if (it != constraints_by_variables.end()) {
+            for (int id : it->second) {
+                if (coefficients[id] == constraint.get_coefficients()) {
+                    return id;
+                }
+            }
+        }
+        return -1;
+    }
+
+    int add(const LPConstraint &constraint, int row) {
+        int id = size();
+        constraints_by_variables[constraint.get_variables()].push_back(id);
+        variables.push_back(constraint.get_variables());
+        coefficients.push_back(constraint.get_coefficients());
+        rows.push_back(row);
+        lower_bounds.push_back(0);
+        upper_bounds.push_back(0);
+        is_active.push_back(false);
+        position_in_inactive.push_back(inactive.end());
+        activate(id, constraint.get_lower_bound(), constraint.get_upper_bound());
+        return id;
+    }
+
+    // Id of the least recently used inactive constraint, or -1 if all are active
+    int get_least_recently_used() const {
+        return inactive.empty() ? -1 : inactive.front();
+    }
+
+    /*
+      Replace the inactive constraint id by the given one and activate it.
+      Returns the coefficients that the row of id needs for this: the new
+      coefficients and 0 for the old variables that do not occur any more.
+    */
+    pair<vector<int>, vector<double>> replace(int id, const LPConstraint &constraint) {
+        assert(!is_active[id]);
+        vector<int> &ids = constraints_by_variables[variables[id]];
+        ids.erase(::find(ids.begin(), ids.end(), id));
+        if (ids.empty()) {
+            constraints_by_variables.erase(variables[id]);
+        }
+        constraints_by_variables[constraint.get_variables()].push_back(id);
+
+        pair<vector<int>, vector<double>> row_changes(
+            constraint.get_variables(), constraint.get_coefficients());
+        for (int var : variables[id]) {
+            if (::find(row_changes.first.begin(), row_changes.first.end(), var) == row_changes.first.end()) {
+                row_changes.first.push_back(var);
+                row_changes.second.push_back(0);
+            }
+        }
+        variables[id] = constraint.get_variables();
+        coefficients[id] = constraint.get_coefficients();
+        activate(id, constraint.get_lower_bound(), constraint.get_upper_bound());
+        return row_changes;
+    }
+
+    void activate(int id, double lower_bound, double upper_bound) {
+        assert(!is_active[id]);
+        if (position_in_inactive[id] != inactive.end()) {
+            inactive.erase(position_in_inactive[id]);
+            position_in_inactive[id] = inactive.end();
+        }
+        lower_bounds[id] = lower_bound;
+        upper_bounds[id] = upper_bound;
+        is_active[id] = true;
+        active.push_back(id);
+    }
+
+    void deactivate_all() {
+        for (int id : active) {
+            is_active[id] = false;
+            position_in_inactive[id] = inactive.insert(inactive.end(), id);
+        }
+        active.clear();
+    }
+};
+
 LPSolver::LPSolver(LPSolverType solver_type) {
     string missing_solver;
     switch (solver_type) {
@@ -148,15 +263,82 @@ LPSolver::LPSolver(LPSolverType solver_type) {
     }
 }
 
+LPSolver::~LPSolver() = default;
+
 void LPSolver::load_problem(const LinearProgram &lp) {
+    constraint_pool = nullptr;
     pimpl->load_problem(lp);
 }
 
+void LPSolver::enable_constraint_pool(int max_size) {
+    assert(!has_temporary_constraints());
+    constraint_pool = make_unique<ConstraintPool>(max_size);
+}
+
 void LPSolver::add_temporary_constraints(const named_vector::NamedVector<LPConstraint> &constraints) {
-    pimpl->add_temporary_constraints(constraints);
+    if (!constraint_pool) {
+        pimpl->add_temporary_constraints(constraints);
+        return;
+    }
+
+    ConstraintPool &pool = *constraint_pool;
+    named_vector::NamedVector<LPConstraint> new_constraints;
+    named_vector::NamedVector<LPConstraint> unpooled_constraints;
+    vector<int> changed_constraints;
+    for (const LPConstraint &constraint : constraints) {
+        int id = pool.find(constraint);
+        if (id == -1) {
+            if (pool.size() >= pool.max_size) {
+                // Reuse the row of the constraint that was not needed for the longest time
+                id = pool.get_least_recently_used();
+                if (id == -1) {
+                    unpooled_constraints.push_back(constraint);
+                } else {
+                    auto [variables, coefficients] = pool.replace(id, constraint);
+                    pimpl->set_constraint_coefficients(pool.rows[id], variables, coefficients);
+                    changed_constraints.push_back(id);
+                }
+                continue;
+            }
+            // Rows can only be added permanently while there are no other temporary rows
+            if (pimpl->has_temporary_constraints()) {
+                unpooled_constraints.push_back(constraint);
+                continue;
+            }
+            pool.add(constraint, pimpl->get_num_constraints() + new_constraints.size());
+            new_constraints.push_back(constraint);
+        } else if (pool.is_active[id]) {
+            // The same constraint was added twice for this evaluation
+            pool.lower_bounds[id] = max(pool.lower_bounds[id], constraint.get_lower_bound());
+            pool.upper_bounds[id] = min(pool.upper_bounds[id], constraint.get_upper_bound());
+            changed_constraints.push_back(id);
+        } else {
+            pool.activate(id, constraint.get_lower_bound(), constraint.get_upper_bound());
+            changed_constraints.push_back(id);
+        }
+    }
+
+    if (new_constraints.size() > 0) {
+        pimpl->add_permanent_constraints(new_constraints);
+    }
+    for (int id : changed_constraints) {
+        pimpl->set_constraint_lower_bound(pool.rows[id], pool.lower_bounds[id]);
+        pimpl->set_constraint_upper_bound(pool.rows[id], pool.upper_bounds[id]);
+    }
+    if (unpooled_constraints.size() > 0) {
+        pimpl->add_temporary_constraints(unpooled_constraints);
+    }
 }
 
 void LPSolver::clear_temporary_constraints() {
+    if (constraint_pool) {
+        double infinity = pimpl->get_infinity();
+        for (int id : constraint_pool->active) {
+            pimpl->set_constraint_lower_bound(constraint_pool->rows[id], -infinity);
+            pimpl->set_constraint_upper_bound(constraint_pool->rows[id], infinity);
+        }
+        constraint_pool->deactivate_all();
+    }
     pimpl->clear_temporary_constraints();
 }
 
@@ -233,7 +415,8 @@ int LPSolver::get_num_constraints() const {
 }
 
 int LPSolver::has_temporary_constraints() const {
-    return pimpl->has_temporary_constraints();
+    return pimpl->has_temporary_constraints() ||
+           (constraint_pool && !constraint_pool->active.empty());
 }
 
 void LPSolver::print_statistics() const {
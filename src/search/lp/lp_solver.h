@@ -98,14 +98,32 @@ public:
     const std::string &get_objective_name() const;
 };
 
+class ConstraintPool;
+
 class LPSolver {
     std::unique_ptr<SolverInterface> pimpl;
+    std::unique_ptr<ConstraintPool> constraint_pool;
 public:
     explicit LPSolver(LPSolverType solver_type);
+    ~LPSolver();
 
     void load_problem(const LinearProgram &lp);
     void add_temporary_constraints(const named_vector::NamedVector<LPConstraint> &constraints);
     void clear_temporary_constraints();
+
+    /*
+      Keep up to max_size temporary constraints in the LP after they are
+      cleared. Instead of removing them, their bounds are relaxed, and a
+      temporary constraint with the same coefficients added later only changes
+      the bounds of the existing row again. The matrix then stays the same
+      across evaluations, so the solver can re-solve from the previous basis
+      (dual simplex) instead of starting over. When the pool is full, a new
+      constraint replaces the coefficients of the pooled constraint that has
+      not been used for the most evaluations. Only if all pooled constraints are
+      used in the current evaluation, it is added and removed as usual.
+      Must be called after load_problem.
+    */
+    void enable_constraint_pool(int max_size);
     double get_infinity() const;
 
     void set_objective_coefficients(const std::vector<double> &coefficients);
@@ -19,6 +19,7 @@ public:
 
     virtual void load_problem(const LinearProgram &lp) = 0;
     virtual void add_temporary_constraints(const named_vector::NamedVector<LPConstraint> &constraints) = 0;
+    virtual void add_permanent_constraints(const named_vector::NamedVector<LPConstraint> &constraints) = 0;
     virtual void clear_temporary_constraints() = 0;
     virtual double get_infinity() const = 0;
 
@@ -26,6 +27,9 @@ public:
     virtual void set_objective_coefficient(int index, double coefficient) = 0;
     virtual void set_constraint_lower_bound(int index, double bound) = 0;
     virtual void set_constraint_upper_bound(int index, double bound) = 0;
+    // Set the coefficients of the given (distinct) variables in a constraint; other coefficients are unchanged.
+    virtual void set_constraint_coefficients(
+        int index, const std::vector<int> &variables, const std::vector<double> &coefficients) = 0;
     virtual void set_variable_lower_bound(int index, double bound) = 0;
     virtual void set_variable_upper_bound(int index, double bound) = 0;
 
@@ -4,6 +4,8 @@
 
 #include "../utils/system.h"
 
+#include <cassert>
+
 using namespace std;
 using namespace soplex;
 
@@ -72,6 +74,12 @@ void SoPlexSolverInterface::add_temporary_constraints(const named_vector::NamedV
     num_temporary_constraints = constraints.size();
 }
 
+void SoPlexSolverInterface::add_permanent_constraints(const named_vector::NamedVector<LPConstraint> &constraints) {
+    assert(!has_temporary_constraints());
+    soplex.addRowsReal(constraints_to_row_set(constraints));
+    num_permanent_constraints += constraints.size();
+}
+
 void SoPlexSolverInterface::clear_temporary_constraints() {
     if (has_temporary_constraints()) {
         int first = num_permanent_constraints;
@@ -104,6 +112,14 @@ void SoPlexSolverInterface::set_constraint_upper_bound(int index, double bound)
     soplex.changeRhsReal(index, bound);
 }
 
+void SoPlexSolverInterface::set_constraint_coefficients(
+    int index, const vector<int> &variables, const vector<double> &coefficients) {
+    assert(variables.size() == coefficients.size());
+    for (size_t i = 0; i < variables.size(); ++i) {
+        soplex.changeElementReal(index, variables[i], coefficients[i]);
+    }
+}
+
 void SoPlexSolverInterface::set_variable_lower_bound(int index, double bound) {
     soplex.changeLowerReal(index, bound);
 }
@@ -10,6 +10,7 @@
 #include "../utils/logging.h"
 #include "../utils/system.h"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
@@ -49,7 +50,8 @@ FactoredTransitionSystem::FactoredTransitionSystem(
       distances(move(distances)),
       compute_init_distances(compute_init_distances),
       compute_goal_distances(compute_goal_distances),
-      num_active_entries(this->transition_systems.size()) {
+      num_active_entries(this->transition_systems.size()),
+      peak_merge_memory(0) {
     for (size_t index = 0; index < this->transition_systems.size(); ++index) {
         if (compute_init_distances || compute_goal_distances) {
             this->distances[index]->compute_distances(
@@ -66,7 +68,8 @@ FactoredTransitionSystem::FactoredTransitionSystem(FactoredTransitionSystem &&ot
       distances(move(other.distances)),
       compute_init_distances(move(other.compute_init_distances)),
       compute_goal_distances(move(other.compute_goal_distances)),
-      num_active_entries(move(other.num_active_entries)) {
+      num_active_entries(move(other.num_active_entries)),
+      peak_merge_memory(other.peak_merge_memory) {
     /*
       This is just a default move constructor. Unfortunately Visual
       Studio does not support "= default" for move construction or
@@ -163,12 +166,15 @@ int FactoredTransitionSystem::merge(
     utils::LogProxy &log) {
     assert(is_component_valid(index1));
     assert(is_component_valid(index2));
+    size_t merge_memory = 0;
     transition_systems.push_back(
         TransitionSystem::merge(
             *labels,
             *transition_systems[index1],
             *transition_systems[index2],
-            log));
+            log,
+            &merge_memory));
+    peak_merge_memory = max(peak_merge_memory, merge_memory);
     distances[index1] = nullptr;
     distances[index2] = nullptr;
     transition_systems[index1] = nullptr;
@@ -68,6 +68,8 @@ class FactoredTransitionSystem {
     const bool compute_init_distances;
     const bool compute_goal_distances;
     int num_active_entries;
+    // Largest number of bytes allocated to compute a single product.
+    size_t peak_merge_memory;
 
     /*
       Assert that the factor at the given index is in a consistent state, i.e.
@@ -184,6 +186,10 @@ public:
         return num_active_entries;
     }
 
+    size_t get_peak_merge_memory() const {
+        return peak_merge_memory;
+    }
+
     // Used by LabelReduction and MergeScoringFunctionDFP
     const Labels &get_labels() const {
         return *labels;
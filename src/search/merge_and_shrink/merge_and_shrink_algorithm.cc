@@ -44,13 +44,14 @@ MergeAndShrinkAlgorithm::MergeAndShrinkAlgorithm(
     bool prune_unreachable_states, bool prune_irrelevant_states,
     int max_states, int max_states_before_merge,
     int threshold_before_merge, double main_loop_max_time,
-    utils::Verbosity verbosity)
+    utils::Verbosity verbosity, int max_total_states)
     : merge_strategy_factory(merge_strategy),
       shrink_strategy(shrink_strategy),
       label_reduction(label_reduction),
       max_states(max_states),
       max_states_before_merge(max_states_before_merge),
       shrink_threshold_before_merge(threshold_before_merge),
+      max_total_states(max_total_states),
       prune_unreachable_states(prune_unreachable_states),
       prune_irrelevant_states(prune_irrelevant_states),
       log(utils::get_log_for_verbosity(verbosity)),
@@ -136,6 +137,10 @@ void MergeAndShrinkAlgorithm::dump_options() const {
             << max_states_before_merge << endl;
         log << "Threshold to trigger shrinking right before merge: "
             << shrink_threshold_before_merge << endl;
+        if (max_total_states != INF) {
+            log << "Limit on the total size of all transition systems: "
+                << max_total_states << endl;
+        }
         log << endl;
 
         shrink_strategy->dump_options(log);
@@ -220,6 +225,30 @@ bool MergeAndShrinkAlgorithm::ran_out_of_time(
     return false;
 }
 
+bool MergeAndShrinkAlgorithm::exceeds_total_size_limit(
+    const FactoredTransitionSystem &fts, int index1, int index2) const {
+    if (max_total_states == INF) {
+        return false;
+    }
+    int size1 = fts.get_transition_system(index1).get_size();
+    int size2 = fts.get_transition_system(index2).get_size();
+    long long total_size = 0;
+    for (int index : fts) {
+        total_size += fts.get_transition_system(index).get_size();
+    }
+    long long merged_size = min(static_cast<long long>(size1) * size2,
+                                static_cast<long long>(max_states));
+    if (total_size - size1 - size2 + merged_size > max_total_states) {
+        if (log.is_at_least_normal()) {
+            log << "Merging would exceed the limit of " << max_total_states
+                << " states in total, stopping computation." << endl;
+            log << endl;
+        }
+        return true;
+    }
+    return false;
+}
+
 void MergeAndShrinkAlgorithm::main_loop(
     FactoredTransitionSystem &fts,
     const TaskProxy &task_proxy) {
@@ -310,7 +339,8 @@ void MergeAndShrinkAlgorithm::main_loop(
             }
         }
 
-        if (ran_out_of_time(timer)) {
+        if (ran_out_of_time(timer) ||
+            exceeds_total_size_limit(fts, merge_index1, merge_index2)) {
             break;
         }
 
@@ -379,6 +409,8 @@ void MergeAndShrinkAlgorithm::main_loop(
     log << "Main loop runtime: " << timer.get_elapsed_time() << endl;
     log << "Maximum intermediate abstraction size: "
         << maximum_intermediate_size << endl;
+    log << "Peak memory of a single product computation: "
+        << fts.get_peak_merge_memory() / 1024 << " KB" << endl;
     shrink_strategy = nullptr;
     label_reduction = nullptr;
 }
@@ -3,6 +3,7 @@
 
 #include "../utils/logging.h"
 
+#include <limits>
 #include <memory>
 
 class TaskProxy;
@@ -38,6 +39,9 @@ class MergeAndShrinkAlgorithm {
     /* A soft limit for triggering shrinking even if the hard limits
        max_states and max_states_before_merge are not violated. */
     int shrink_threshold_before_merge;
+    /* Stop merging (but keep the remaining factors) when the sum of the
+       sizes of all factors would exceed this limit after a merge. */
+    int max_total_states;
 
     // Options for pruning
     const bool prune_unreachable_states;
@@ -52,6 +56,8 @@ class MergeAndShrinkAlgorithm {
     void dump_options() const;
     void warn_on_unusual_options() const;
     bool ran_out_of_time(const utils::CountdownTimer &timer) const;
+    bool exceeds_total_size_limit(
+        const FactoredTransitionSystem &fts, int index1, int index2) const;
     void statistics(int maximum_intermediate_size) const;
     void main_loop(
         FactoredTransitionSystem &fts,
@@ -65,7 +71,8 @@ public:
         bool prune_unreachable_states, bool prune_irrelevant_states,
         int max_states, int max_states_before_merge,
         int threshold_before_merge, double main_loop_max_time,
-        utils::Verbosity verbosity);
+        utils::Verbosity verbosity,
+        int max_total_states = std::numeric_limits<int>::max());
     FactoredTransitionSystem build_factored_transition_system(const TaskProxy &task_proxy);
 };
 
@@ -5,6 +5,7 @@
 
 #include "../task_proxy.h"
 
+#include "../utils/binary_file.h"
 #include "../utils/logging.h"
 
 #include <algorithm>
@@ -26,6 +27,21 @@ int MergeAndShrinkRepresentation::get_domain_size() const {
     return domain_size;
 }
 
+// Tags that identify the type of each node in the binary serialization
+static const uint8_t LEAF_TAG = 0;
+static const uint8_t MERGE_TAG = 1;
+
+unique_ptr<MergeAndShrinkRepresentation> MergeAndShrinkRepresentation::load(
+    utils::BinaryReader &reader) {
+    uint8_t tag = reader.read<uint8_t>();
+    if (tag == LEAF_TAG) {
+        return make_unique<MergeAndShrinkRepresentationLeaf>(reader);
+    } else if (tag == MERGE_TAG) {
+        return make_unique<MergeAndShrinkRepresentationMerge>(reader);
+    }
+    throw utils::BinaryFileError("unknown merge-and-shrink representation");
+}
+
 
 MergeAndShrinkRepresentationLeaf::MergeAndShrinkRepresentationLeaf(
     int var_id, int domain_size)
@@ -35,6 +51,28 @@ MergeAndShrinkRepresentationLeaf::MergeAndShrinkRepresentationLeaf(
     iota(lookup_table.begin(), lookup_table.end(), 0);
 }
 
+MergeAndShrinkRepresentationLeaf::MergeAndShrinkRepresentationLeaf(
+    utils::BinaryReader &reader)
+    : MergeAndShrinkRepresentation(0),
+      var_id(reader.read<int>()) {
+    domain_size = reader.read<int>();
+    lookup_table = reader.read_vector<int>();
+}
+
+void MergeAndShrinkRepresentationLeaf::save(utils::BinaryWriter &writer) const {
+    writer.write(LEAF_TAG);
+    writer.write(var_id);
+    writer.write(domain_size);
+    writer.write_vector(lookup_table);
+}
+
+int MergeAndShrinkRepresentationLeaf::flatten(
+    FlatMergeAndShrinkRepresentation &flat) const {
+    flat.nodes.push_back({var_id, -1, -1, 0, static_cast<int>(flat.table.size())});
+    flat.table.insert(flat.table.end(), lookup_table.begin(), lookup_table.end());
+    return flat.nodes.size() - 1;
+}
+
 void MergeAndShrinkRepresentationLeaf::set_distances(
     const Distances &distances) {
     assert(distances.are_goal_distances_computed());
@@ -107,6 +145,42 @@ MergeAndShrinkRepresentationMerge::MergeAndShrinkRepresentationMerge(
     }
 }
 
+MergeAndShrinkRepresentationMerge::MergeAndShrinkRepresentationMerge(
+    utils::BinaryReader &reader)
+    : MergeAndShrinkRepresentation(0) {
+    domain_size = reader.read<int>();
+    left_child = load(reader);
+    right_child = load(reader);
+    lookup_table.resize(reader.read<uint64_t>());
+    for (vector<int> &row : lookup_table) {
+        row = reader.read_vector<int>();
+    }
+}
+
+void MergeAndShrinkRepresentationMerge::save(utils::BinaryWriter &writer) const {
+    writer.write(MERGE_TAG);
+    writer.write(domain_size);
+    left_child->save(writer);
+    right_child->save(writer);
+    writer.write<uint64_t>(lookup_table.size());
+    for (const vector<int> &row : lookup_table) {
+        writer.write_vector(row);
+    }
+}
+
+int MergeAndShrinkRepresentationMerge::flatten(
+    FlatMergeAndShrinkRepresentation &flat) const {
+    int left = left_child->flatten(flat);
+    int right = right_child->flatten(flat);
+    int stride = lookup_table.empty() ? 0 : lookup_table[0].size();
+    flat.nodes.push_back({-1, left, right, stride, static_cast<int>(flat.table.size())});
+    for (const vector<int> &row : lookup_table) {
+        assert(static_cast<int>(row.size()) == stride);
+        flat.table.insert(flat.table.end(), row.begin(), row.end());
+    }
+    return flat.nodes.size() - 1;
+}
+
 void MergeAndShrinkRepresentationMerge::set_distances(
     const Distances &distances) {
     assert(distances.are_goal_distances_computed());
@@ -7,11 +7,35 @@
 class State;
 
 namespace utils {
+class BinaryReader;
+class BinaryWriter;
 class LogProxy;
 }
 
 namespace merge_and_shrink {
 class Distances;
+
+/*
+  One or several representations stored in flat arrays, so that they can be
+  evaluated without virtual calls or pointer chasing. Nodes are stored in
+  post-order, i.e., the children of a node come before it.
+*/
+struct FlatMergeAndShrinkRepresentation {
+    struct Node {
+        // Variable of a leaf node, -1 for merge nodes
+        int var;
+        // Children of a merge node
+        int left_child;
+        int right_child;
+        // Length of the rows of the lookup table of a merge node
+        int stride;
+        // Position of the lookup table in table
+        int offset;
+    };
+    std::vector<Node> nodes;
+    std::vector<int> table;
+};
+
 class MergeAndShrinkRepresentation {
 protected:
     int domain_size;
@@ -39,6 +63,13 @@ public:
        to PRUNED_STATE. */
     virtual bool is_total() const = 0;
     virtual void dump(utils::LogProxy &log) const = 0;
+
+    // Binary serialization of the whole tree, read back with load
+    virtual void save(utils::BinaryWriter &writer) const = 0;
+    static std::unique_ptr<MergeAndShrinkRepresentation> load(utils::BinaryReader &reader);
+
+    // Appends the tree to flat and returns the index of its root node
+    virtual int flatten(FlatMergeAndShrinkRepresentation &flat) const = 0;
 };
 
 
@@ -48,6 +79,7 @@ class MergeAndShrinkRepresentationLeaf : public MergeAndShrinkRepresentation {
     std::vector<int> lookup_table;
 public:
     MergeAndShrinkRepresentationLeaf(int var_id, int domain_size);
+    explicit MergeAndShrinkRepresentationLeaf(utils::BinaryReader &reader);
     virtual ~MergeAndShrinkRepresentationLeaf() = default;
 
     virtual void set_distances(const Distances &) override;
@@ -57,6 +89,8 @@ public:
     virtual int get_value(const std::vector<int> &state) const override;
     virtual bool is_total() const override;
     virtual void dump(utils::LogProxy &log) const override;
+    virtual void save(utils::BinaryWriter &writer) const override;
+    virtual int flatten(FlatMergeAndShrinkRepresentation &flat) const override;
 };
 
 
@@ -68,6 +102,7 @@ public:
     MergeAndShrinkRepresentationMerge(
         std::unique_ptr<MergeAndShrinkRepresentation> left_child,
         std::unique_ptr<MergeAndShrinkRepresentation> right_child);
+    explicit MergeAndShrinkRepresentationMerge(utils::BinaryReader &reader);
     virtual ~MergeAndShrinkRepresentationMerge() = default;
 
     virtual void set_distances(const Distances &distances) override;
@@ -77,6 +112,8 @@ public:
     virtual int get_value(const std::vector<int> &state) const override;
     virtual bool is_total() const override;
     virtual void dump(utils::LogProxy &log) const override;
+    virtual void save(utils::BinaryWriter &writer) const override;
+    virtual int flatten(FlatMergeAndShrinkRepresentation &flat) const override;
 };
 }
 
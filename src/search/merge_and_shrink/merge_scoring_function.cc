@@ -12,6 +12,13 @@ MergeScoringFunction::MergeScoringFunction()
     : initialized(false) {
 }
 
+vector<double> MergeScoringFunction::compute_scores_in_parallel(
+    const FactoredTransitionSystem &fts,
+    const vector<pair<int, int>> &merge_candidates,
+    utils::ThreadPool &) {
+    return compute_scores(fts, merge_candidates);
+}
+
 void MergeScoringFunction::dump_options(utils::LogProxy &log) const {
     if (log.is_at_least_normal()) {
         log << "Merge scoring function:" << endl;
@@ -8,6 +8,7 @@ class TaskProxy;
 
 namespace utils {
 class LogProxy;
+class ThreadPool;
 }
 
 namespace merge_and_shrink {
@@ -23,6 +24,14 @@ public:
     virtual std::vector<double> compute_scores(
         const FactoredTransitionSystem &fts,
         const std::vector<std::pair<int, int>> &merge_candidates) = 0;
+    /*
+      Same as compute_scores, but may distribute the work over the threads of
+      the pool. The default implementation computes the scores sequentially.
+    */
+    virtual std::vector<double> compute_scores_in_parallel(
+        const FactoredTransitionSystem &fts,
+        const std::vector<std::pair<int, int>> &merge_candidates,
+        utils::ThreadPool &pool);
     virtual bool requires_init_distances() const = 0;
     virtual bool requires_goal_distances() const = 0;
 
@@ -7,7 +7,9 @@
 
 #include "../plugins/plugin.h"
 #include "../utils/markup.h"
+#include "../utils/thread_pool.h"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
@@ -58,6 +60,20 @@ static vector<int> compute_label_ranks(
     return label_ranks;
 }
 
+static int compute_pair_weight(
+    const vector<int> &label_ranks1, const vector<int> &label_ranks2) {
+    assert(label_ranks1.size() == label_ranks2.size());
+    int pair_weight = INF;
+    for (size_t i = 0; i < label_ranks1.size(); ++i) {
+        if (label_ranks1[i] != -1 && label_ranks2[i] != -1) {
+            // label is relevant in both transition_systems
+            int max_label_rank = max(label_ranks1[i], label_ranks2[i]);
+            pair_weight = min(pair_weight, max_label_rank);
+        }
+    }
+    return pair_weight;
+}
+
 vector<double> MergeScoringFunctionDFP::compute_scores(
     const FactoredTransitionSystem &fts,
     const vector<pair<int, int>> &merge_candidates) {
@@ -80,19 +96,37 @@ vector<double> MergeScoringFunctionDFP::compute_scores(
         if (label_ranks2.empty()) {
             label_ranks2 = compute_label_ranks(fts, ts_index2);
         }
-        assert(label_ranks1.size() == label_ranks2.size());
-
-        // Compute the weight associated with this pair
-        int pair_weight = INF;
-        for (size_t i = 0; i < label_ranks1.size(); ++i) {
-            if (label_ranks1[i] != -1 && label_ranks2[i] != -1) {
-                // label is relevant in both transition_systems
-                int max_label_rank = max(label_ranks1[i], label_ranks2[i]);
-                pair_weight = min(pair_weight, max_label_rank);
-            }
-        }
-        scores.push_back(pair_weight);
+        scores.push_back(compute_pair_weight(label_ranks1, label_ranks2));
+    }
+    return scores;
+}
+
+vector<double> MergeScoringFunctionDFP::compute_scores_in_parallel(
+    const FactoredTransitionSystem &fts,
+    const vector<pair<int, int>> &merge_candidates,
+    utils::ThreadPool &pool) {
+    // First compute the label ranks of all transition systems involved...
+    vector<int> ts_indices;
+    for (pair<int, int> merge_candidate : merge_candidates) {
+        ts_indices.push_back(merge_candidate.first);
+        ts_indices.push_back(merge_candidate.second);
     }
+    sort(ts_indices.begin(), ts_indices.end());
+    ts_indices.erase(unique(ts_indices.begin(), ts_indices.end()), ts_indices.end());
+
+    vector<vector<int>> transition_system_label_ranks(fts.get_size());
+    pool.parallel_for(ts_indices.size(), [&](int i) {
+        int ts_index = ts_indices[i];
+        transition_system_label_ranks[ts_index] = compute_label_ranks(fts, ts_index);
+    });
+
+    // ...and then the weights of the pairs, which only read them.
+    vector<double> scores(merge_candidates.size());
+    pool.parallel_for(merge_candidates.size(), [&](int i) {
+        const auto &[ts_index1, ts_index2] = merge_candidates[i];
+        scores[i] = compute_pair_weight(transition_system_label_ranks[ts_index1],
+                                        transition_system_label_ranks[ts_index2]);
+    });
     return scores;
 }
 
@@ -11,6 +11,10 @@ public:
     virtual std::vector<double> compute_scores(
         const FactoredTransitionSystem &fts,
         const std::vector<std::pair<int, int>> &merge_candidates) override;
+    virtual std::vector<double> compute_scores_in_parallel(
+        const FactoredTransitionSystem &fts,
+        const std::vector<std::pair<int, int>> &merge_candidates,
+        utils::ThreadPool &pool) override;
 
     virtual bool requires_init_distances() const override {
         return false;
@@ -12,6 +12,7 @@
 #include "../plugins/plugin.h"
 #include "../utils/logging.h"
 #include "../utils/markup.h"
+#include "../utils/thread_pool.h"
 
 using namespace std;
 
@@ -28,6 +29,42 @@ MergeScoringFunctionMIASM::MergeScoringFunctionMIASM(
       silent_log(utils::get_silent_log()) {
 }
 
+double MergeScoringFunctionMIASM::compute_score(
+    const FactoredTransitionSystem &fts, int index1, int index2,
+    utils::LogProxy &log) const {
+    unique_ptr<TransitionSystem> product = shrink_before_merge_externally(
+        fts,
+        index1,
+        index2,
+        *shrink_strategy,
+        max_states,
+        max_states_before_merge,
+        shrink_threshold_before_merge,
+        log);
+
+    // Compute distances for the product and count the alive states.
+    unique_ptr<Distances> distances = make_unique<Distances>(*product);
+    const bool compute_init_distances = true;
+    const bool compute_goal_distances = true;
+    distances->compute_distances(compute_init_distances, compute_goal_distances, log);
+    int num_states = product->get_size();
+    int alive_states_count = 0;
+    for (int state = 0; state < num_states; ++state) {
+        if (distances->get_init_distance(state) != INF &&
+            distances->get_goal_distance(state) != INF) {
+            ++alive_states_count;
+        }
+    }
+
+    /*
+      Compute the score as the ratio of alive states of the product
+      compared to the number of states of the full product.
+    */
+    assert(num_states);
+    return static_cast<double>(alive_states_count) /
+           static_cast<double>(num_states);
+}
+
 vector<double> MergeScoringFunctionMIASM::compute_scores(
     const FactoredTransitionSystem &fts,
     const vector<pair<int, int>> &merge_candidates) {
@@ -40,37 +77,7 @@ vector<double> MergeScoringFunctionMIASM::compute_scores(
         if (use_caching && cached_scores_by_merge_candidate_indices[index1][index2]) {
             score = *cached_scores_by_merge_candidate_indices[index1][index2];
         } else {
-            unique_ptr<TransitionSystem> product = shrink_before_merge_externally(
-                fts,
-                index1,
-                index2,
-                *shrink_strategy,
-                max_states,
-                max_states_before_merge,
-                shrink_threshold_before_merge,
-                silent_log);
-
-            // Compute distances for the product and count the alive states.
-            unique_ptr<Distances> distances = make_unique<Distances>(*product);
-            const bool compute_init_distances = true;
-            const bool compute_goal_distances = true;
-            distances->compute_distances(compute_init_distances, compute_goal_distances, silent_log);
-            int num_states = product->get_size();
-            int alive_states_count = 0;
-            for (int state = 0; state < num_states; ++state) {
-                if (distances->get_init_distance(state) != INF &&
-                    distances->get_goal_distance(state) != INF) {
-                    ++alive_states_count;
-                }
-            }
-
-            /*
-              Compute the score as the ratio of alive states of the product
-              compared to the number of states of the full product.
-            */
-            assert(num_states);
-            score = static_cast<double>(alive_states_count) /
-                static_cast<double>(num_states);
+            score = compute_score(fts, index1, index2, silent_log);
             if (use_caching) {
                 cached_scores_by_merge_candidate_indices[index1][index2] = score;
             }
@@ -80,6 +87,43 @@ vector<double> MergeScoringFunctionMIASM::compute_scores(
     return scores;
 }
 
+vector<double> MergeScoringFunctionMIASM::compute_scores_in_parallel(
+    const FactoredTransitionSystem &fts,
+    const vector<pair<int, int>> &merge_candidates,
+    utils::ThreadPool &pool) {
+    if (!shrink_strategy->is_thread_safe()) {
+        return compute_scores(fts, merge_candidates);
+    }
+
+    vector<double> scores(merge_candidates.size());
+    vector<int> uncached_candidates;
+    for (size_t i = 0; i < merge_candidates.size(); ++i) {
+        auto [index1, index2] = merge_candidates[i];
+        if (use_caching && cached_scores_by_merge_candidate_indices[index1][index2]) {
+            scores[i] = *cached_scores_by_merge_candidate_indices[index1][index2];
+        } else {
+            uncached_candidates.push_back(i);
+        }
+    }
+
+    // Each product is computed independently, with its own log
+    pool.parallel_for(uncached_candidates.size(), [&](int i) {
+        int candidate = uncached_candidates[i];
+        utils::LogProxy log = utils::get_silent_log();
+        scores[candidate] = compute_score(
+            fts, merge_candidates[candidate].first,
+            merge_candidates[candidate].second, log);
+    });
+
+    if (use_caching) {
+        for (int candidate : uncached_candidates) {
+            auto [index1, index2] = merge_candidates[candidate];
+            cached_scores_by_merge_candidate_indices[index1][index2] = scores[candidate];
+        }
+    }
+    return scores;
+}
+
 void MergeScoringFunctionMIASM::initialize(const TaskProxy &task_proxy) {
     initialized = true;
     int num_variables = task_proxy.get_variables().size();
@@ -17,8 +17,17 @@ class MergeScoringFunctionMIASM : public MergeScoringFunction {
     const int max_states_before_merge;
     const int shrink_threshold_before_merge;
     utils::LogProxy silent_log;
+    /*
+      Only accessed by the calling thread: compute_scores_in_parallel looks up
+      the cached scores before and stores the new ones after the parallel loop.
+    */
     std::vector<std::vector<std::optional<double>>> cached_scores_by_merge_candidate_indices;
 
+    // Does not modify the object, so it can be called concurrently
+    double compute_score(
+        const FactoredTransitionSystem &fts, int index1, int index2,
+        utils::LogProxy &log) const;
+
     virtual std::string name() const override;
     virtual void dump_function_specific_options(utils::LogProxy &log) const override;
 public:
@@ -29,6 +38,10 @@ public:
     virtual std::vector<double> compute_scores(
         const FactoredTransitionSystem &fts,
         const std::vector<std::pair<int, int>> &merge_candidates) override;
+    virtual std::vector<double> compute_scores_in_parallel(
+        const FactoredTransitionSystem &fts,
+        const std::vector<std::pair<int, int>> &merge_candidates,
+        utils::ThreadPool &pool) override;
     virtual void initialize(const TaskProxy &task_proxy) override;
 
     virtual bool requires_init_distances() const override {
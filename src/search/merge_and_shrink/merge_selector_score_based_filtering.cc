@@ -4,6 +4,7 @@
 #include "merge_scoring_function.h"
 
 #include "../plugins/plugin.h"
+#include "../utils/thread_pool.h"
 
 #include <cassert>
 
@@ -11,10 +12,14 @@ using namespace std;
 
 namespace merge_and_shrink {
 MergeSelectorScoreBasedFiltering::MergeSelectorScoreBasedFiltering(
-    const vector<shared_ptr<MergeScoringFunction>> &scoring_functions)
-    : merge_scoring_functions(scoring_functions) {
+    const vector<shared_ptr<MergeScoringFunction>> &scoring_functions,
+    int num_threads)
+    : merge_scoring_functions(scoring_functions),
+      num_threads(num_threads) {
 }
 
+MergeSelectorScoreBasedFiltering::~MergeSelectorScoreBasedFiltering() = default;
+
 static vector<pair<int, int>> get_remaining_candidates(
     const vector<pair<int, int>> &merge_candidates,
     const vector<double> &scores) {
@@ -43,8 +48,10 @@ pair<int, int> MergeSelectorScoreBasedFiltering::select_merge(
 
     for (const shared_ptr<MergeScoringFunction> &scoring_function :
          merge_scoring_functions) {
-        vector<double> scores = scoring_function->compute_scores(
-            fts, merge_candidates);
+        vector<double> scores = thread_pool ?
+            scoring_function->compute_scores_in_parallel(
+                fts, merge_candidates, *thread_pool) :
+            scoring_function->compute_scores(fts, merge_candidates);
         merge_candidates = get_remaining_candidates(merge_candidates, scores);
         if (merge_candidates.size() == 1) {
             break;
@@ -62,6 +69,9 @@ pair<int, int> MergeSelectorScoreBasedFiltering::select_merge(
 }
 
 void MergeSelectorScoreBasedFiltering::initialize(const TaskProxy &task_proxy) {
+    if (num_threads > 1 && !thread_pool) {
+        thread_pool = make_unique<utils::ThreadPool>(num_threads);
+    }
     for (shared_ptr<MergeScoringFunction> &scoring_function
          : merge_scoring_functions) {
         scoring_function->initialize(task_proxy);
@@ -75,6 +85,7 @@ string MergeSelectorScoreBasedFiltering::name() const {
 void MergeSelectorScoreBasedFiltering::dump_selector_specific_options(
     utils::LogProxy &log) const {
     if (log.is_at_least_normal()) {
+        log << "Threads: " << num_threads << endl;
         for (const shared_ptr<MergeScoringFunction> &scoring_function
              : merge_scoring_functions) {
             scoring_function->dump_options(log);
@@ -115,13 +126,27 @@ public:
         add_list_option<shared_ptr<MergeScoringFunction>>(
             "scoring_functions",
             "The list of scoring functions used to compute scores for candidates.");
+        add_option<int>(
+            "threads",
+            "Number of threads used to compute the scores of the candidates. "
+            "Only miasm and dfp make use of them; the result does not depend "
+            "on the number of threads.",
+            "1",
+            plugins::Bounds("1", "infinity"));
+
+        document_note(
+            "Parallel scoring",
+            "sf_miasm only computes the products concurrently if its shrink "
+            "strategy does not use random numbers, e.g. with shrink_bisimulation. "
+            "Otherwise, the results would depend on the scheduling of the threads.");
     }
 
     virtual shared_ptr<MergeSelectorScoreBasedFiltering>
     create_component(const plugins::Options &opts) const override {
         return make_shared<MergeSelectorScoreBasedFiltering>(
             opts.get_list<shared_ptr<MergeScoringFunction>>(
-                "scoring_functions")
+                "scoring_functions"),
+            opts.get<int>("threads")
             );
     }
 };
@@ -10,16 +10,25 @@ namespace plugins {
 class Options;
 }
 
+namespace utils {
+class ThreadPool;
+}
+
 namespace merge_and_shrink {
 class MergeScoringFunction;
 class MergeSelectorScoreBasedFiltering : public MergeSelector {
     std::vector<std::shared_ptr<MergeScoringFunction>> merge_scoring_functions;
+    int num_threads;
+    // Used to score the candidates concurrently if num_threads > 1
+    std::unique_ptr<utils::ThreadPool> thread_pool;
 protected:
     virtual std::string name() const override;
     virtual void dump_selector_specific_options(utils::LogProxy &log) const override;
 public:
-    explicit MergeSelectorScoreBasedFiltering(
-        const std::vector<std::shared_ptr<MergeScoringFunction>> &scoring_functions);
+    MergeSelectorScoreBasedFiltering(
+        const std::vector<std::shared_ptr<MergeScoringFunction>> &scoring_functions,
+        int num_threads);
+    virtual ~MergeSelectorScoreBasedFiltering() override;
     virtual std::pair<int, int> select_merge(
         const FactoredTransitionSystem &fts,
         const std::vector<int> &indices_subset = std::vector<int>()) const override;
@@ -6,6 +6,7 @@
 
 #include "../plugins/plugin.h"
 #include "../utils/collections.h"
+#include "../utils/hash.h"
 #include "../utils/logging.h"
 #include "../utils/markup.h"
 #include "../utils/system.h"
@@ -15,6 +16,8 @@
 #include <limits>
 #include <iostream>
 #include <memory>
+#include <numeric>
+#include <tuple>
 #include <unordered_map>
 
 using namespace std;
@@ -93,9 +96,11 @@ struct Signature {
 };
 
 
-ShrinkBisimulation::ShrinkBisimulation(bool greedy, AtLimit at_limit)
+ShrinkBisimulation::ShrinkBisimulation(
+    bool greedy, AtLimit at_limit, SignatureRefinement refinement)
     : greedy(greedy),
-      at_limit(at_limit) {
+      at_limit(at_limit),
+      refinement(refinement) {
 }
 
 int ShrinkBisimulation::initialize_groups(
@@ -235,24 +240,16 @@ void ShrinkBisimulation::compute_signatures(
     ::sort(signatures.begin(), signatures.end());
 }
 
-StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
+int ShrinkBisimulation::refine_groups_by_sorting(
     const TransitionSystem &ts,
     const Distances &distances,
     int target_size,
-    utils::LogProxy &) const {
-    assert(distances.are_goal_distances_computed());
+    int num_groups,
+    vector<int> &state_to_group) const {
     int num_states = ts.get_size();
-
-    vector<int> state_to_group(num_states);
     vector<Signature> signatures;
     signatures.reserve(num_states + 2);
 
-    int num_groups = initialize_groups(ts, distances, state_to_group);
-    // log << "number of initial groups: " << num_groups << endl;
-
-    // TODO: We currently violate this; see issue250
-    // assert(num_groups <= target_size);
-
     bool stable = false;
     bool stop_requested = false;
     while (!stable && !stop_requested && num_groups < target_size) {
@@ -338,10 +335,307 @@ StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
         }
     }
 
-    /* Reduce memory pressure before generating the equivalence
-       relation since this is one of the code parts relevant to peak
-       memory. */
-    utils::release_vector_memory(signatures);
+    return num_groups;
+}
+
+/*
+  Transitions that are relevant for the bisimulation, grouped by source state
+  (forward) and by target state (backward). Entries of the forward lists are
+  pairs (label group ID, target state).
+*/
+struct TransitionIndex {
+    vector<int> forward_begin;
+    vector<pair<int, int>> forward;
+    vector<int> backward_begin;
+    vector<int> backward;
+
+    TransitionIndex(const TransitionSystem &ts, const Distances &distances,
+                    bool greedy) {
+        int num_states = ts.get_size();
+        vector<tuple<int, int, int>> transitions;
+        int label_group_counter = 0;
+        for (const LocalLabelInfo &local_label_info : ts) {
+            for (const Transition &transition : local_label_info.get_transitions()) {
+                if (greedy) {
+                    // Same as in compute_signatures.
+                    int src_h = distances.get_goal_distance(transition.src);
+                    int target_h = distances.get_goal_distance(transition.target);
+                    if (src_h == INF || target_h == INF ||
+                        target_h + local_label_info.get_cost() != src_h) {
+                        continue;
+                    }
+                }
+                transitions.emplace_back(transition.src, label_group_counter,
+                                         transition.target);
+            }
+            ++label_group_counter;
+        }
+
+        forward_begin.assign(num_states + 1, 0);
+        backward_begin.assign(num_states + 1, 0);
+        for (const auto &[src, label_group, target] : transitions) {
+            ++forward_begin[src + 1];
+            ++backward_begin[target + 1];
+        }
+        for (int state = 0; state < num_states; ++state) {
+            forward_begin[state + 1] += forward_begin[state];
+            backward_begin[state + 1] += backward_begin[state];
+        }
+        forward.resize(transitions.size());
+        backward.resize(transitions.size());
+        vector<int> forward_pos(forward_begin.begin(), forward_begin.end() - 1);
+        vector<int> backward_pos(backward_begin.begin(), backward_begin.end() - 1);
+        for (const auto &[src, label_group, target] : transitions) {
+            forward[forward_pos[src]++] = make_pair(label_group, target);
+            backward[backward_pos[target]++] = src;
+        }
+    }
+};
+
+int ShrinkBisimulation::refine_groups_by_hashing(
+    const TransitionSystem &ts,
+    const Distances &distances,
+    int target_size,
+    int num_groups,
+    vector<int> &state_to_group) const {
+    int num_states = ts.get_size();
+    TransitionIndex index(ts, distances, greedy);
+
+    // Groups are processed in the same order as by the sorting refinement.
+    vector<int> group_h_and_goal(num_groups);
+    for (int state = 0; state < num_states; ++state) {
+        int h = distances.get_goal_distance(state);
+        group_h_and_goal[state_to_group[state]] =
+            ts.is_goal_state(state) ? -1 : (h == INF ? IRRELEVANT : h);
+    }
+
+    /*
+      keys[state] is the hash of the successor signature of the state. It is
+      only recomputed for dirty states, i.e., states with a successor whose
+      group changed in the previous round. A group without dirty states
+      cannot be split, because all its states had the same signature after
+      the previous round.
+
+      Equal keys do not guarantee equal signatures, so states with the same
+      key are compared by their actual successor signatures before they are
+      kept together. split_before[i] is true iff members[i] starts a new group.
+    */
+    vector<uint64_t> keys(num_states, 0);
+    vector<bool> dirty(num_states, true);
+    vector<bool> split_before(num_states, false);
+    SuccessorSignature succ_signature;
+    SuccessorSignature representative_signature;
+    vector<SuccessorSignature> run_signatures;
+    vector<int> run_order;
+    vector<int> group_begin;
+    vector<int> next_position;
+    vector<int> members;
+    vector<int> candidate_groups;
+    vector<int> changed_states;
+
+    auto compute_succ_signature = [&](int state, SuccessorSignature &signature) {
+        signature.clear();
+        for (int i = index.forward_begin[state]; i < index.forward_begin[state + 1]; ++i) {
+            const auto &[label_group, target] = index.forward[i];
+            signature.emplace_back(label_group, state_to_group[target]);
+        }
+        ::sort(signature.begin(), signature.end());
+        signature.erase(::unique(signature.begin(), signature.end()),
+                        signature.end());
+    };
+
+    /*
+      Split the states members[begin, end), which have the same key, by their
+      successor signatures, setting split_before accordingly. Runs without
+      dirty states are skipped, since their signatures did not change.
+      Usually all states of a run have the same signature, so each of them is
+      compared against the signature of the first one, and the signatures of
+      all states are only stored and sorted if there is a hash collision.
+    */
+    auto split_run_by_signature = [&](int begin, int end) {
+        if (end - begin < 2 ||
+            none_of(members.begin() + begin, members.begin() + end,
+                    [&](int state) {return dirty[state];})) {
+            return;
+        }
+        compute_succ_signature(members[begin], representative_signature);
+        bool collision = false;
+        for (int i = begin + 1; i < end && !collision; ++i) {
+            compute_succ_signature(members[i], succ_signature);
+            collision = succ_signature != representative_signature;
+        }
+        if (!collision) {
+            return;
+        }
+        run_signatures.resize(end - begin);
+        for (int i = begin; i < end; ++i) {
+            compute_succ_signature(members[i], run_signatures[i - begin]);
+        }
+        run_order.resize(end - begin);
+        iota(run_order.begin(), run_order.end(), 0);
+        ::sort(run_order.begin(), run_order.end(),
+               [&](int pos1, int pos2) {
+                   return make_pair(cref(run_signatures[pos1]), members[begin + pos1]) <
+                   make_pair(cref(run_signatures[pos2]), members[begin + pos2]);
+               });
+        vector<int> sorted_members;
+        sorted_members.reserve(end - begin);
+        for (int pos : run_order) {
+            sorted_members.push_back(members[begin + pos]);
+        }
+        for (int i = begin + 1; i < end; ++i) {
+            split_before[i] = run_signatures[run_order[i - begin]] !=
+                run_signatures[run_order[i - begin - 1]];
+        }
+        copy(sorted_members.begin(), sorted_members.end(), members.begin() + begin);
+    };
+
+    bool stable = false;
+    bool stop_requested = false;
+    while (!stable && !stop_requested && num_groups < target_size) {
+        stable = true;
+
+        for (int state = 0; state < num_states; ++state) {
+            if (dirty[state]) {
+                compute_succ_signature(state, succ_signature);
+                keys[state] = utils::get_hash64(succ_signature);
+            }
+        }
+
+        // Sort the states by group (counting sort).
+        group_begin.assign(num_groups + 1, 0);
+        for (int state = 0; state < num_states; ++state) {
+            ++group_begin[state_to_group[state] + 1];
+        }
+        for (int group = 0; group < num_groups; ++group) {
+            group_begin[group + 1] += group_begin[group];
+        }
+        members.resize(num_states);
+        next_position.assign(group_begin.begin(), group_begin.end() - 1);
+        for (int state = 0; state < num_states; ++state) {
+            members[next_position[state_to_group[state]]++] = state;
+        }
+
+        candidate_groups.clear();
+        for (int group = 0; group < num_groups; ++group) {
+            if (group_begin[group + 1] - group_begin[group] < 2) {
+                continue;
+            }
+            for (int i = group_begin[group]; i < group_begin[group + 1]; ++i) {
+                if (dirty[members[i]]) {
+                    candidate_groups.push_back(group);
+                    break;
+                }
+            }
+        }
+        ::sort(candidate_groups.begin(), candidate_groups.end(),
+               [&](int group1, int group2) {
+                   return make_pair(group_h_and_goal[group1], group1) <
+                   make_pair(group_h_and_goal[group2], group2);
+               });
+        changed_states.clear();
+
+        size_t block_start = 0;
+        while (block_start < candidate_groups.size()) {
+            // All candidate groups with the same h value form a block.
+            int h_and_goal = group_h_and_goal[candidate_groups[block_start]];
+            size_t block_end = block_start;
+            int num_extra_groups = 0;
+            for (; block_end < candidate_groups.size() &&
+                 group_h_and_goal[candidate_groups[block_end]] == h_and_goal;
+                 ++block_end) {
+                int group = candidate_groups[block_end];
+                ::sort(members.begin() + group_begin[group],
+                     members.begin() + group_begin[group + 1],
+                     [&](int state1, int state2) {
+                         return make_pair(keys[state1], state1) <
+                         make_pair(keys[state2], state2);
+                     });
+                int run_start = group_begin[group];
+                for (int i = group_begin[group] + 1; i <= group_begin[group + 1]; ++i) {
+                    if (i < group_begin[group + 1] &&
+                        keys[members[i]] == keys[members[i - 1]]) {
+                        split_before[i] = false;
+                        continue;
+                    }
+                    split_run_by_signature(run_start, i);
+                    if (i < group_begin[group + 1]) {
+                        split_before[i] = true;
+                    }
+                    run_start = i;
+                }
+                for (int i = group_begin[group] + 1; i < group_begin[group + 1]; ++i) {
+                    if (split_before[i]) {
+                        ++num_extra_groups;
+                    }
+                }
+            }
+
+            if (at_limit == AtLimit::RETURN &&
+                num_groups + num_extra_groups > target_size) {
+                stop_requested = true;
+                break;
+            } else if (num_extra_groups > 0) {
+                stable = false;
+                for (size_t b = block_start; b < block_end && num_groups < target_size; ++b) {
+                    int group = candidate_groups[b];
+                    // The states with the first signature keep the old group number.
+                    int new_group_no = group;
+                    for (int i = group_begin[group] + 1; i < group_begin[group + 1]; ++i) {
+                        int state = members[i];
+                        if (split_before[i]) {
+                            if (num_groups == target_size) {
+                                break;
+                            }
+                            new_group_no = num_groups++;
+                            group_h_and_goal.push_back(h_and_goal);
+                        }
+                        if (new_group_no != group) {
+                            state_to_group[state] = new_group_no;
+                            changed_states.push_back(state);
+                        }
+                    }
+                }
+                if (num_groups == target_size) {
+                    break;
+                }
+            }
+            block_start = block_end;
+        }
+
+        ::fill(dirty.begin(), dirty.end(), false);
+        for (int state : changed_states) {
+            for (int i = index.backward_begin[state]; i < index.backward_begin[state + 1]; ++i) {
+                dirty[index.backward[i]] = true;
+            }
+        }
+    }
+    return num_groups;
+}
+
+StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
+    const TransitionSystem &ts,
+    const Distances &distances,
+    int target_size,
+    utils::LogProxy &) const {
+    assert(distances.are_goal_distances_computed());
+    int num_states = ts.get_size();
+
+    vector<int> state_to_group(num_states);
+
+    int num_groups = initialize_groups(ts, distances, state_to_group);
+    // log << "number of initial groups: " << num_groups << endl;
+
+    // TODO: We currently violate this; see issue250
+    // assert(num_groups <= target_size);
+
+    if (refinement == SignatureRefinement::HASHING) {
+        num_groups = refine_groups_by_hashing(
+            ts, distances, target_size, num_groups, state_to_group);
+    } else {
+        num_groups = refine_groups_by_sorting(
+            ts, distances, target_size, num_groups, state_to_group);
+    }
 
     // Generate final result.
     StateEquivalenceRelation equivalence_relation;
@@ -373,6 +667,9 @@ void ShrinkBisimulation::dump_strategy_specific_options(utils::LogProxy &log) co
             ABORT("Unknown setting for at_limit.");
         }
         log << endl;
+        log << "Signature refinement: "
+            << (refinement == SignatureRefinement::HASHING ? "hashing" : "sorting")
+            << endl;
     }
 }
 
@@ -398,6 +695,10 @@ public:
         add_option<AtLimit>(
             "at_limit",
             "what to do when the size limit is hit", "return");
+        add_option<SignatureRefinement>(
+            "refinement",
+            "how the groups of states are split in each round",
+            "sorting");
 
         document_note(
             "shrink_bisimulation(greedy=true)",
@@ -426,7 +727,8 @@ public:
     create_component(const plugins::Options &opts) const override {
         return make_shared<ShrinkBisimulation>(
             opts.get<bool>("greedy"),
-            opts.get<AtLimit>("at_limit")
+            opts.get<AtLimit>("at_limit"),
+            opts.get<SignatureRefinement>("refinement")
             );
     }
 };
@@ -440,4 +742,18 @@ static plugins::TypedEnumPlugin<AtLimit> _enum_plugin({
          "continue refining the equivalence class until "
          "the size limit is hit"}
     });
+
+static plugins::TypedEnumPlugin<SignatureRefinement> _refinement_enum_plugin({
+        {"sorting",
+         "build the successor signatures of all states and sort them in "
+         "every round"},
+        {"hashing",
+         "hash the successor signature of each state into a 64-bit key, and "
+         "only recompute the keys of states with a successor that changed its "
+         "group in the previous round. Rounds take roughly linear time and "
+         "need much less memory. Without size limit, the result is the same as "
+         "with sorting (unless two signatures have the same hash, which is "
+         "extremely unlikely). When the size limit is hit, different groups "
+         "may be split."}
+    });
 }
@@ -11,9 +11,15 @@ enum class AtLimit {
     USE_UP
 };
 
+enum class SignatureRefinement {
+    SORTING,
+    HASHING
+};
+
 class ShrinkBisimulation : public ShrinkStrategy {
     const bool greedy;
     const AtLimit at_limit;
+    const SignatureRefinement refinement;
 
     void compute_abstraction(
         const TransitionSystem &ts,
@@ -31,11 +37,29 @@ class ShrinkBisimulation : public ShrinkStrategy {
         const Distances &distances,
         std::vector<Signature> &signatures,
         const std::vector<int> &state_to_group) const;
+
+    /*
+      Split the groups until they are stable or the size limit is reached,
+      and return the new number of groups.
+    */
+    int refine_groups_by_sorting(
+        const TransitionSystem &ts,
+        const Distances &distances,
+        int target_size,
+        int num_groups,
+        std::vector<int> &state_to_group) const;
+    int refine_groups_by_hashing(
+        const TransitionSystem &ts,
+        const Distances &distances,
+        int target_size,
+        int num_groups,
+        std::vector<int> &state_to_group) const;
 protected:
     virtual void dump_strategy_specific_options(utils::LogProxy &log) const override;
     virtual std::string name() const override;
 public:
-    explicit ShrinkBisimulation(bool greedy, AtLimit at_limit);
+    ShrinkBisimulation(
+        bool greedy, AtLimit at_limit, SignatureRefinement refinement);
     virtual StateEquivalenceRelation compute_equivalence_relation(
         const TransitionSystem &ts,
         const Distances &distances,
@@ -49,6 +73,10 @@ public:
     virtual bool requires_goal_distances() const override {
         return true;
     }
+
+    virtual bool preserves_bisimulation() const override {
+        return !greedy;
+    }
 };
 }
 
@@ -57,6 +57,11 @@ public:
         const Distances &distances,
         int target_size,
         utils::LogProxy &log) const override;
+
+    // All calls share the random number generator
+    virtual bool is_thread_safe() const override {
+        return false;
+    }
 };
 
 extern void add_shrink_bucket_options_to_feature(
@@ -44,6 +44,24 @@ public:
     virtual bool requires_init_distances() const = 0;
     virtual bool requires_goal_distances() const = 0;
 
+    /*
+      Return true if compute_equivalence_relation may be called concurrently
+      from several threads, and its results do not depend on the order of the
+      calls.
+    */
+    virtual bool is_thread_safe() const {
+        return true;
+    }
+
+    /*
+      Return true if the equivalence relations computed without a size limit
+      (i.e., with target_size = INF) are bisimulations, so that shrinking
+      preserves all transitions between the abstract states.
+    */
+    virtual bool preserves_bisimulation() const {
+        return false;
+    }
+
     void dump_options(utils::LogProxy &log) const;
     std::string get_name() const;
 };
@@ -9,6 +9,7 @@
 #include <cassert>
 #include <iostream>
 #include <set>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -156,11 +157,89 @@ TransitionSystem::TransitionSystem(const TransitionSystem &other)
 TransitionSystem::~TransitionSystem() {
 }
 
+/*
+  A block of transitions of a local label that all have the same source
+  state, given as the range [begin, end) of its transitions.
+*/
+struct SourceBlock {
+    int src;
+    int begin;
+    int end;
+};
+
+/*
+  The transitions of all local labels of a transition system, partitioned
+  into source blocks. Since the transitions of each local label are sorted,
+  the blocks of a local label are contiguous and sorted by source, and the
+  blocks of all local labels are stored in a single array (compressed sparse
+  row format).
+*/
+class SourceBlocks {
+    // The blocks of local label l are blocks[label_begin[l], label_begin[l + 1]).
+    vector<int> label_begin;
+    vector<SourceBlock> blocks;
+public:
+    explicit SourceBlocks(const vector<LocalLabelInfo> &local_label_infos) {
+        label_begin.reserve(local_label_infos.size() + 1);
+        for (const LocalLabelInfo &local_label_info : local_label_infos) {
+            label_begin.push_back(blocks.size());
+            const vector<Transition> &transitions = local_label_info.get_transitions();
+            int num_transitions = transitions.size();
+            for (int i = 0; i < num_transitions; ++i) {
+                if (i == 0 || transitions[i].src != transitions[i - 1].src) {
+                    if (i != 0) {
+                        blocks.back().end = i;
+                    }
+                    blocks.push_back({transitions[i].src, i, num_transitions});
+                }
+            }
+        }
+        label_begin.push_back(blocks.size());
+        blocks.shrink_to_fit();
+    }
+
+    span<const SourceBlock> get_blocks(int local_label) const {
+        return span<const SourceBlock>(blocks).subspan(
+            label_begin[local_label], label_begin[local_label + 1] - label_begin[local_label]);
+    }
+
+    size_t estimate_memory() const {
+        return label_begin.capacity() * sizeof(int) + blocks.capacity() * sizeof(SourceBlock);
+    }
+};
+
+/*
+  Append the product of the transitions of two local labels to
+  new_transitions. Iterating over pairs of source blocks rather than over
+  pairs of transitions generates the product transitions ordered by
+  source and target, so they do not need to be sorted afterwards.
+*/
+static void compute_product_transitions(
+    const vector<Transition> &transitions1,
+    span<const SourceBlock> blocks1,
+    const vector<Transition> &transitions2,
+    span<const SourceBlock> blocks2,
+    int multiplier,
+    vector<Transition> &new_transitions) {
+    for (const SourceBlock &block1 : blocks1) {
+        for (const SourceBlock &block2 : blocks2) {
+            int src = block1.src * multiplier + block2.src;
+            for (int i = block1.begin; i < block1.end; ++i) {
+                int target_offset = transitions1[i].target * multiplier;
+                for (int j = block2.begin; j < block2.end; ++j) {
+                    new_transitions.emplace_back(src, target_offset + transitions2[j].target);
+                }
+            }
+        }
+    }
+}
+
 unique_ptr<TransitionSystem> TransitionSystem::merge(
     const Labels &labels,
     const TransitionSystem &ts1,
     const TransitionSystem &ts2,
-    utils::LogProxy &log) {
+    utils::LogProxy &log,
+    size_t *peak_memory) {
     if (log.is_at_least_verbose()) {
         log << "Merging " << ts1.get_description() << " and "
             << ts2.get_description() << endl;
@@ -195,6 +274,11 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
     }
     assert(init_state != -1);
 
+    SourceBlocks source_blocks1(ts1.local_label_infos);
+    SourceBlocks source_blocks2(ts2.local_label_infos);
+    size_t memory = source_blocks1.estimate_memory() + source_blocks2.estimate_memory() +
+        label_to_local_label.capacity() * sizeof(int) + goal_states.capacity() / 8;
+
     /*
       We can compute the local equivalence relation of a composite T
       from the local equivalence relations of the two components T1 and T2:
@@ -206,59 +290,74 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
     */
     int multiplier = ts2_size;
     LabelGroup dead_labels;
-    for (const LocalLabelInfo &local_label_info : ts1) {
+    /*
+      The labels of a group of ts1 are distributed among "buckets"
+      corresponding to the groups of ts2. Buckets are kept in the order in
+      which the groups of ts2 are first encountered, and since the labels of
+      the group are sorted, so are the labels of every bucket.
+    */
+    vector<int> local_label2_to_bucket(ts2.local_label_infos.size(), -1);
+    vector<int> bucket_local_labels2;
+    vector<LabelGroup> buckets;
+    for (int local_label1 = 0; local_label1 < static_cast<int>(ts1.local_label_infos.size());
+         ++local_label1) {
+        const LocalLabelInfo &local_label_info = ts1.local_label_infos[local_label1];
+        if (!local_label_info.is_active()) {
+            continue;
+        }
         const LabelGroup &group1 = local_label_info.get_label_group();
         const vector<Transition> &transitions1 = local_label_info.get_transitions();
 
-        // Distribute the labels of this group among the "buckets"
-        // corresponding to the groups of ts2.
-        unordered_map<int, LabelGroup> buckets;
         for (int label : group1) {
             int ts_local_label2 = ts2.label_to_local_label[label];
-            buckets[ts_local_label2].push_back(label);
+            int &bucket = local_label2_to_bucket[ts_local_label2];
+            if (bucket == -1) {
+                bucket = bucket_local_labels2.size();
+                bucket_local_labels2.push_back(ts_local_label2);
+                buckets.emplace_back();
+            }
+            buckets[bucket].push_back(label);
         }
         // Now buckets contains all equivalence classes that are
         // refinements of group1.
 
         // Now create the new groups together with their transitions.
-        for (auto &bucket : buckets) {
+        for (size_t bucket = 0; bucket < buckets.size(); ++bucket) {
+            int ts_local_label2 = bucket_local_labels2[bucket];
+            local_label2_to_bucket[ts_local_label2] = -1;
             const vector<Transition> &transitions2 =
-                ts2.local_label_infos[bucket.first].get_transitions();
+                ts2.local_label_infos[ts_local_label2].get_transitions();
+            LabelGroup &new_labels = buckets[bucket];
+
+            // Create a new group if the transitions are not empty
+            if (transitions1.empty() || transitions2.empty()) {
+                dead_labels.insert(dead_labels.end(), new_labels.begin(), new_labels.end());
+                continue;
+            }
 
-            // Create the new transitions for this bucket
+            // The size of the product is known, so it is allocated only once.
             vector<Transition> new_transitions;
-            if (!transitions1.empty() && !transitions2.empty()
-                && transitions1.size() > new_transitions.max_size() / transitions2.size())
+            if (transitions1.size() > new_transitions.max_size() / transitions2.size())
                 utils::exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
             new_transitions.reserve(transitions1.size() * transitions2.size());
-            for (const Transition &transition1 : transitions1) {
-                int src1 = transition1.src;
-                int target1 = transition1.target;
-                for (const Transition &transition2 : transitions2) {
-                    int src2 = transition2.src;
-                    int target2 = transition2.target;
-                    int src = src1 * multiplier + src2;
-                    int target = target1 * multiplier + target2;
-                    new_transitions.emplace_back(src, target);
-                }
-            }
+            compute_product_transitions(
+                transitions1, source_blocks1.get_blocks(local_label1),
+                transitions2, source_blocks2.get_blocks(ts_local_label2),
+                multiplier, new_transitions);
+            assert(new_transitions.size() == transitions1.size() * transitions2.size());
+            memory += new_transitions.capacity() * sizeof(Transition) +
+                new_labels.size() * sizeof(int);
 
-            // Create a new group if the transitions are not empty
-            LabelGroup &new_labels = bucket.second;
-            if (new_transitions.empty()) {
-                dead_labels.insert(dead_labels.end(), new_labels.begin(), new_labels.end());
-            } else {
-                sort(new_transitions.begin(), new_transitions.end());
-                sort(new_labels.begin(), new_labels.end());
-                int new_local_label = local_label_infos.size();
-                int cost = INF;
-                for (int label : new_labels) {
-                    cost = min(ts1.labels.get_label_cost(label), cost);
-                    label_to_local_label[label] = new_local_label;
-                }
-                local_label_infos.emplace_back(move(new_labels), move(new_transitions), cost);
+            int new_local_label = local_label_infos.size();
+            int cost = INF;
+            for (int label : new_labels) {
+                cost = min(ts1.labels.get_label_cost(label), cost);
+                label_to_local_label[label] = new_local_label;
             }
+            local_label_infos.emplace_back(move(new_labels), move(new_transitions), cost);
         }
+        bucket_local_labels2.clear();
+        buckets.clear();
     }
 
     /*
@@ -276,10 +375,24 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
             cost = min(cost, ts1.labels.get_label_cost(label));
             label_to_local_label[label] = new_local_label;
         }
+        memory += dead_labels.capacity() * sizeof(int);
         // Dead labels have empty transitions
         local_label_infos.emplace_back(move(dead_labels), vector<Transition>(), cost);
     }
 
+    /*
+      Nothing is released before the end of the product computation, so
+      the peak is reached here.
+    */
+    memory += local_label_infos.capacity() * sizeof(LocalLabelInfo) +
+        local_label2_to_bucket.capacity() * sizeof(int);
+    if (log.is_at_least_verbose()) {
+        log << "Memory used to compute the product: " << memory / 1024 << " KB" << endl;
+    }
+    if (peak_memory) {
+        *peak_memory = memory;
+    }
+
     return make_unique<TransitionSystem>(
         num_variables,
         move(incorporated_variables),
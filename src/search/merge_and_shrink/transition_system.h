@@ -212,12 +212,16 @@ public:
 
       Invariant: the children ts1 and ts2 must be solvable.
       (It is a bug to merge an unsolvable transition system.)
+
+      If peak_memory is given, it is set to the number of bytes allocated
+      by the product computation, including its temporary data.
     */
     static std::unique_ptr<TransitionSystem> merge(
         const Labels &labels,
         const TransitionSystem &ts1,
         const TransitionSystem &ts2,
-        utils::LogProxy &log);
+        utils::LogProxy &log,
+        size_t *peak_memory = nullptr);
 
     /*
       Applies the given state equivalence relation to the transition system.
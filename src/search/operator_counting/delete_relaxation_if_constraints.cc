@@ -224,15 +224,16 @@ void DeleteRelaxationIFConstraints::initialize_constraints(
 
 bool DeleteRelaxationIFConstraints::update_constraints(
     const State &state, lp::LPSolver &lp_solver) {
+    vector<FactPair> &solver_last_state = last_state[&lp_solver];
     // Unset old bounds.
-    for (FactPair f : last_state) {
+    for (FactPair f : solver_last_state) {
         lp_solver.set_constraint_lower_bound(get_constraint_id(f), 0);
     }
-    last_state.clear();
+    solver_last_state.clear();
     // Set new bounds.
     for (FactProxy f : state) {
         lp_solver.set_constraint_lower_bound(get_constraint_id(f.get_pair()), -1);
-        last_state.push_back(f.get_pair());
+        solver_last_state.push_back(f.get_pair());
     }
     return false;
 }
@@ -6,6 +6,7 @@
 #include "../task_proxy.h"
 
 #include <memory>
+#include <unordered_map>
 
 namespace lp {
 class LPConstraint;
@@ -48,9 +49,11 @@ class DeleteRelaxationIFConstraints : public ConstraintGenerator {
        Indexed with var.id, value */
     std::vector<std::vector<int>> constraint_ids;
 
-    /* The state that is currently used for setting the bounds. Remembering
-       this makes it faster to unset the bounds when the state changes. */
-    std::vector<FactPair> last_state;
+    /* The state that is currently used for setting the bounds in each LP.
+       Remembering this makes it faster to unset the bounds when the state
+       changes. The heuristic may evaluate states on several copies of the LP
+       (one per thread), so the state is kept separately for each solver. */
+    std::unordered_map<const lp::LPSolver *, std::vector<FactPair>> last_state;
 
     int get_var_op_used(const OperatorProxy &op);
     int get_var_fact_reached(FactPair f);
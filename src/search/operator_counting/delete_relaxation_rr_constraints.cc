@@ -535,19 +535,20 @@ void DeleteRelaxationRRConstraints::initialize_constraints(
 bool DeleteRelaxationRRConstraints::update_constraints(
     const State &state, lp::LPSolver &lp_solver) {
     // Unset old bounds.
+    vector<FactPair> &solver_last_state = last_state[&lp_solver];
     int con_id;
-    for (FactPair f : last_state) {
+    for (FactPair f : solver_last_state) {
         con_id = get_constraint_id(f);
         lp_solver.set_constraint_lower_bound(con_id, 0);
         lp_solver.set_constraint_upper_bound(con_id, 0);
     }
-    last_state.clear();
+    solver_last_state.clear();
     // Set new bounds.
     for (FactProxy f : state) {
         con_id = get_constraint_id(f.get_pair());
         lp_solver.set_constraint_lower_bound(con_id, 1);
         lp_solver.set_constraint_upper_bound(con_id, 1);
-        last_state.push_back(f.get_pair());
+        solver_last_state.push_back(f.get_pair());
     }
     return false;
 }
@@ -7,6 +7,7 @@
 #include "../utils/hash.h"
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace lp {
@@ -78,9 +79,11 @@ class DeleteRelaxationRRConstraints : public ConstraintGenerator {
     */
     std::vector<int> constraint_offsets;
 
-    /* The state that is currently used for setting the bounds. Remembering
-       this makes it faster to unset the bounds when the state changes. */
-    std::vector<FactPair> last_state;
+    /* The state that is currently used for setting the bounds in each LP.
+       Remembering this makes it faster to unset the bounds when the state
+       changes. The heuristic may evaluate states on several copies of the LP
+       (one per thread), so the state is kept separately for each solver. */
+    std::unordered_map<const lp::LPSolver *, std::vector<FactPair>> last_state;
 
 
     int get_constraint_id(FactPair f) const;
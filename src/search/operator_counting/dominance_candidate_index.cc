@@ -0,0 +1,105 @@
+#include "dominance_candidate_index.h"
+
+#include "../dominance/factor_dominance_relation.h"
+#include "../dominance/state_dominance_relation.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+using namespace std;
+
+namespace operator_counting {
+    DominanceCandidateIndex::DominanceCandidateIndex(const dominance::StateDominanceRelation &relation)
+        : num_factors(relation.size()), num_words(0) {
+        simulated_values.resize(num_factors);
+        simulating_states.resize(num_factors);
+        for (int factor = 0; factor < num_factors; ++factor) {
+            const dominance::FactorDominanceRelation &factor_relation = relation[factor];
+            simulated_values[factor].resize(factor_relation.get_num_states());
+            simulating_states[factor].resize(factor_relation.get_num_states());
+            factor_relation.apply_to_simulations_until([&](int s, int t) {
+                simulated_values[factor][s].push_back(t);
+                return false;
+            });
+        }
+    }
+
+    int DominanceCandidateIndex::insert(const vector<int> &state, int g) {
+        const int id = g_values.size();
+        g_values.push_back(g);
+        states.insert(states.end(), state.begin(), state.end());
+        first_occurrence.try_emplace(make_pair(state, g), id);
+
+        if (id / BITS_PER_WORD >= num_words) {
+            ++num_words;
+            word_min_g.push_back(g);
+            word_max_g.push_back(g);
+            for (auto &factor_bitsets : simulating_states) {
+                for (auto &bitset : factor_bitsets) {
+                    bitset.push_back(0);
+                }
+            }
+        } else {
+            word_min_g.back() = min(word_min_g.back(), g);
+            word_max_g.back() = max(word_max_g.back(), g);
+        }
+
+        const Word bit = Word(1) << (id % BITS_PER_WORD);
+        for (int factor = 0; factor < num_factors; ++factor) {
+            for (int t : simulated_values[factor][state[factor]]) {
+                simulating_states[factor][t][id / BITS_PER_WORD] |= bit;
+            }
+        }
+        return id;
+    }
+
+    bool DominanceCandidateIndex::find_candidates(const vector<int> &state, int g, vector<int> &candidates) const {
+        candidates.clear();
+
+        // States stored after an identical state with the same g value are later in the evaluation order
+        int limit = g_values.size();
+        auto it = first_occurrence.find(make_pair(state, g));
+        if (it != first_occurrence.end()) {
+            limit = it->second;
+        }
+
+        const int limit_words = (limit + BITS_PER_WORD - 1) / BITS_PER_WORD;
+        for (int w = 0; w < limit_words; ++w) {
+            if (word_min_g[w] > g) {
+                continue;
+            }
+
+            const int begin = w * BITS_PER_WORD;
+            const int end = min(begin + BITS_PER_WORD, limit);
+            Word valid;
+            if (word_max_g[w] <= g && end - begin == BITS_PER_WORD) {
+                valid = numeric_limits<Word>::max();
+            } else {
+                valid = 0;
+                for (int id = begin; id < end; ++id) {
+                    if (g_values[id] <= g) {
+                        valid |= Word(1) << (id - begin);
+                    }
+                }
+            }
+
+            // all: simulate in every factor so far, almost: simulate in every factor so far but at most one
+            Word all = valid;
+            Word almost = valid;
+            for (int factor = 0; factor < num_factors && almost; ++factor) {
+                const Word simulating = simulating_states[factor][state[factor]][w];
+                almost = (almost & simulating) | all;
+                all &= simulating;
+            }
+
+            if (all) {
+                return true;
+            }
+            for (Word word = almost; word; word &= word - 1) {
+                candidates.push_back(begin + countr_zero(word));
+            }
+        }
+        return false;
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef OPERATOR_COUNTING_DOMINANCE_CANDIDATE_INDEX_H
+#define OPERATOR_COUNTING_DOMINANCE_CANDIDATE_INDEX_H
+
+#include "../utils/hash.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace dominance {
+    class StateDominanceRelation;
+}
+
+namespace operator_counting {
+    /*
+     * Index over the states evaluated so far by QualifiedDominanceConstraints. For each value of each factor, a
+     * bitset over the stored states marks those whose value simulates it. A query only looks at the words of stored
+     * states reached with lower or equal g value, and counts per stored state whether all factors simulate or all
+     * but one, so that only the states that can produce a constraint are retrieved.
+     */
+    class DominanceCandidateIndex {
+        using Word = uint64_t;
+        static constexpr int BITS_PER_WORD = 64;
+
+        int num_factors;
+        int num_words;
+        // simulated_values[factor][s]: values of the factor simulated by s
+        std::vector<std::vector<std::vector<int>>> simulated_values;
+        // simulating_states[factor][t]: bitset over the stored states whose value in the factor simulates t
+        std::vector<std::vector<std::vector<Word>>> simulating_states;
+        // Stored states, num_factors values each, and their g values
+        std::vector<int> states;
+        std::vector<int> g_values;
+        // Minimum and maximum g value of the stored states in each word
+        std::vector<int> word_min_g;
+        std::vector<int> word_max_g;
+        // First stored id of each pair (state, g)
+        utils::HashMap<std::pair<std::vector<int>, int>, int> first_occurrence;
+
+    public:
+        explicit DominanceCandidateIndex(const dominance::StateDominanceRelation &relation);
+
+        // Stores the state and returns its id
+        int insert(const std::vector<int> &state, int g);
+
+        /*
+         * Looks for the stored states with g value lower or equal than g that were stored before the first
+         * occurrence of (state, g). Returns true if one of them dominates the state in all factors. Otherwise,
+         * candidates contains, in insertion order, the ids of those that simulate the state in all factors but one.
+         */
+        bool find_candidates(const std::vector<int> &state, int g, std::vector<int> &candidates) const;
+
+        [[nodiscard]] std::span<const int> get_state(int id) const {
+            return std::span<const int>(states).subspan(static_cast<size_t>(id) * num_factors, num_factors);
+        }
+
+        [[nodiscard]] int get_g_value(int id) const {
+            return g_values[id];
+        }
+
+        [[nodiscard]] int size() const {
+            return g_values.size();
+        }
+    };
+}
+
+#endif
@@ -11,9 +11,9 @@
 namespace operator_counting {
     GDependentOperatorCountingHeuristic::GDependentOperatorCountingHeuristic(
         const std::vector<std::shared_ptr<ConstraintGenerator>> &constraint_generators,
-        bool use_integer_operator_counts, lp::LPSolverType lpsolver, const std::shared_ptr<AbstractTask> &transform,
+        bool use_integer_operator_counts, int constraint_pool_size, int num_threads, lp::LPSolverType lpsolver, const std::shared_ptr<AbstractTask> &transform,
         bool cache_estimates, const std::string &description, utils::Verbosity verbosity): OperatorCountingHeuristic(
-        constraint_generators, use_integer_operator_counts, lpsolver, transform, cache_estimates, description,
+        constraint_generators, use_integer_operator_counts, constraint_pool_size, num_threads, lpsolver, transform, cache_estimates, description,
         verbosity) {
         utils::verify_list_not_empty(constraint_generators, "constraint_generators");
     }
@@ -25,6 +25,15 @@ namespace operator_counting {
         return ret;
     }
 
+    bool GDependentOperatorCountingHeuristic::update_constraints(const State& state, int g_value, lp::LPSolver& solver) {
+        for (const auto &generator : constraint_generators) {
+            if (generator->update_constraints_g_value(state, g_value, solver)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     int GDependentOperatorCountingHeuristic::compute_heuristic(const State& ancestor_state) {
         State state = convert_ancestor_state(ancestor_state);
         assert(!lp_solver.has_temporary_constraints());
@@ -96,6 +105,18 @@ namespace operator_counting {
                 "computationally expensive. Turning this option on can thus drastically "
                 "increase the runtime.",
                 "false");
+            add_option<int>(
+                "constraint_pool_size",
+                "maximum number of temporary constraints that are kept in the LP "
+                "after the evaluation of a state, see operatorcounting. 0 disables this.",
+                "0",
+                plugins::Bounds("0", "infinity"));
+            add_option<int>(
+                "threads",
+                "number of threads used to evaluate the successors of a state "
+                "together, see operatorcounting.",
+                "1",
+                plugins::Bounds("1", "infinity"));
             lp::add_lp_solver_option_to_feature(*this);
             add_heuristic_options_to_feature(*this, "operatorcounting");
 
@@ -126,6 +147,8 @@ namespace operator_counting {
                 opts.get_list<std::shared_ptr<ConstraintGenerator>>(
                     "constraint_generators"),
                 opts.get<bool>("use_integer_operator_counts"),
+                opts.get<int>("constraint_pool_size"),
+                opts.get<int>("threads"),
                 lp::get_lp_solver_arguments_from_options(new_opts),
                 get_heuristic_arguments_from_options(new_opts)
                 );
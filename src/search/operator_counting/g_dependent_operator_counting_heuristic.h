@@ -10,12 +10,13 @@ namespace operator_counting {
 
     public:
         GDependentOperatorCountingHeuristic(const std::vector<std::shared_ptr<ConstraintGenerator>>& constraint_generators,
-            bool use_integer_operator_counts, lp::LPSolverType lpsolver, const std::shared_ptr<AbstractTask>& transform,
+            bool use_integer_operator_counts, int constraint_pool_size, int num_threads, lp::LPSolverType lpsolver, const std::shared_ptr<AbstractTask>& transform,
             bool cache_estimates, const std::string& description, utils::Verbosity verbosity);
 
     protected:
         EvaluationResult compute_result(EvaluationContext &eval_context) override;
         int compute_heuristic(const State &ancestor_state) override;
+        bool update_constraints(const State &state, int g_value, lp::LPSolver &solver) override;
     };
 }
 
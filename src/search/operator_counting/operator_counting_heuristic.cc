@@ -2,10 +2,12 @@
 
 #include "constraint_generator.h"
 
+#include "../evaluation_context.h"
 #include "../plugins/plugin.h"
 #include "../utils/component_errors.h"
 #include "../utils/markup.h"
 #include "../utils/strings.h"
+#include "../utils/thread_pool.h"
 
 #include <cmath>
 
@@ -14,7 +16,8 @@ using namespace std;
 namespace operator_counting {
 OperatorCountingHeuristic::OperatorCountingHeuristic(
     const vector<shared_ptr<ConstraintGenerator>> &constraint_generators,
-    bool use_integer_operator_counts, lp::LPSolverType lpsolver,
+    bool use_integer_operator_counts, int constraint_pool_size,
+    int num_threads, lp::LPSolverType lpsolver,
     const shared_ptr<AbstractTask> &transform, bool cache_estimates,
     const string &description, utils::Verbosity verbosity)
     : Heuristic(transform, cache_estimates, description, verbosity),
@@ -40,6 +43,44 @@ OperatorCountingHeuristic::OperatorCountingHeuristic(
 #endif
     std::cout << "Number of lp variables: " << lp.get_variables().size() << std::endl;
     lp_solver.load_problem(lp);
+    if (constraint_pool_size > 0) {
+        lp_solver.enable_constraint_pool(constraint_pool_size);
+    }
+    if (num_threads > 1) {
+        for (int i = 1; i < num_threads; ++i) {
+            auto solver = make_unique<lp::LPSolver>(lpsolver);
+            solver->set_mip_gap(0);
+            solver->load_problem(lp);
+            if (constraint_pool_size > 0) {
+                solver->enable_constraint_pool(constraint_pool_size);
+            }
+            thread_lp_solvers.push_back(move(solver));
+        }
+        thread_pool = make_unique<utils::ThreadPool>(num_threads);
+    }
+}
+
+OperatorCountingHeuristic::~OperatorCountingHeuristic() {
+}
+
+bool OperatorCountingHeuristic::update_constraints(
+    const State &state, int /*g_value*/, lp::LPSolver &solver) {
+    for (const auto &generator : constraint_generators) {
+        if (generator->update_constraints(state, solver)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int OperatorCountingHeuristic::get_heuristic_value(const lp::LPSolver &solver) const {
+    if (solver.has_optimal_solution()) {
+        double epsilon = 0.01;
+        double objective_value = solver.get_objective_value();
+        return static_cast<int>(ceil(objective_value - epsilon));
+    } else {
+        return DEAD_END;
+    }
 }
 
 int OperatorCountingHeuristic::compute_heuristic(const State &ancestor_state) {
@@ -52,19 +93,48 @@ int OperatorCountingHeuristic::compute_heuristic(const State &ancestor_state) {
             return DEAD_END;
         }
     }
-    int result;
     lp_solver.solve();
-    if (lp_solver.has_optimal_solution()) {
-        double epsilon = 0.01;
-        double objective_value = lp_solver.get_objective_value();
-        result = static_cast<int>(ceil(objective_value - epsilon));
-    } else {
-        result = DEAD_END;
-    }
+    int result = get_heuristic_value(lp_solver);
     lp_solver.clear_temporary_constraints();
     return result;
 }
 
+bool OperatorCountingHeuristic::supports_batch_evaluation() const {
+    return thread_pool != nullptr;
+}
+
+void OperatorCountingHeuristic::compute_heuristics(
+    const vector<EvaluationContext *> &eval_contexts, vector<int> &heuristics) {
+    heuristics.assign(eval_contexts.size(), DEAD_END);
+    vector<lp::LPSolver *> solvers = {&lp_solver};
+    for (const auto &solver : thread_lp_solvers) {
+        solvers.push_back(solver.get());
+    }
+
+    vector<bool> dead_end(solvers.size());
+    for (size_t begin = 0; begin < eval_contexts.size(); begin += solvers.size()) {
+        int num_states = min(solvers.size(), eval_contexts.size() - begin);
+        /*
+          The constraint generators are neither thread-safe nor independent
+          of the order in which states are evaluated, so the constraints are
+          added sequentially and only the LPs are solved concurrently.
+        */
+        for (int i = 0; i < num_states; ++i) {
+            EvaluationContext &eval_context = *eval_contexts[begin + i];
+            State state = convert_ancestor_state(eval_context.get_state());
+            assert(!solvers[i]->has_temporary_constraints());
+            dead_end[i] = update_constraints(state, eval_context.get_g_value(), *solvers[i]);
+        }
+        thread_pool->parallel_for(num_states, [&](int i) {
+            if (!dead_end[i]) {
+                solvers[i]->solve();
+                heuristics[begin + i] = get_heuristic_value(*solvers[i]);
+            }
+            solvers[i]->clear_temporary_constraints();
+        });
+    }
+}
+
 class OperatorCountingHeuristicFeature
     : public plugins::TypedFeature<Evaluator, OperatorCountingHeuristic> {
 public:
@@ -100,6 +170,27 @@ public:
             "computationally expensive. Turning this option on can thus drastically "
             "increase the runtime.",
             "false");
+        add_option<int>(
+            "constraint_pool_size",
+            "maximum number of temporary constraints that are kept in the LP "
+            "after the evaluation of a state. Kept constraints are relaxed "
+            "instead of removed and re-activated by changing their bounds if "
+            "the same constraint is generated for a later state, e.g., for a "
+            "sibling. The LP is then re-solved from the previous basis instead "
+            "of being rebuilt. When the pool is full, a new constraint replaces "
+            "the kept constraint that has not been used for the longest time. "
+            "0 disables this.",
+            "0",
+            plugins::Bounds("0", "infinity"));
+        add_option<int>(
+            "threads",
+            "number of threads used to evaluate the successors of a state "
+            "together. The constraints are generated sequentially, and the LPs "
+            "are solved concurrently on separate copies of the LP. Only search "
+            "algorithms that evaluate states in batches (eager search) make use "
+            "of this.",
+            "1",
+            plugins::Bounds("1", "infinity"));
         lp::add_lp_solver_option_to_feature(*this);
         add_heuristic_options_to_feature(*this, "operatorcounting");
 
@@ -128,6 +219,8 @@ public:
             opts.get_list<shared_ptr<ConstraintGenerator>>(
                 "constraint_generators"),
             opts.get<bool>("use_integer_operator_counts"),
+            opts.get<int>("constraint_pool_size"),
+            opts.get<int>("threads"),
             lp::get_lp_solver_arguments_from_options(opts),
             get_heuristic_arguments_from_options(opts)
             );
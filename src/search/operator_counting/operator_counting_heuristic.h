@@ -12,6 +12,10 @@ namespace plugins {
 class Options;
 }
 
+namespace utils {
+class ThreadPool;
+}
+
 namespace operator_counting {
 class ConstraintGenerator;
 
@@ -19,18 +23,38 @@ class OperatorCountingHeuristic : public Heuristic {
 protected:
     std::vector<std::shared_ptr<ConstraintGenerator>> constraint_generators;
     lp::LPSolver lp_solver;
+    /*
+      For batch evaluation with several threads, one copy of the LP for each
+      additional thread and the pool that solves them concurrently.
+    */
+    std::vector<std::unique_ptr<lp::LPSolver>> thread_lp_solvers;
+    std::unique_ptr<utils::ThreadPool> thread_pool;
 #ifndef NDEBUG
     named_vector::NamedVector<lp::LPVariable> lp_variables;
 #endif
     virtual int compute_heuristic(const State &ancestor_state) override;
+    virtual void compute_heuristics(
+        const std::vector<EvaluationContext *> &eval_contexts,
+        std::vector<int> &heuristics) override;
+    virtual bool supports_batch_evaluation() const override;
+
+    /*
+      Add the constraints of all generators for the state to the LP. Returns
+      true if a generator detected a dead end.
+    */
+    virtual bool update_constraints(
+        const State &state, int g_value, lp::LPSolver &solver);
+    int get_heuristic_value(const lp::LPSolver &solver) const;
 public:
     OperatorCountingHeuristic(
         const std::vector<std::shared_ptr<ConstraintGenerator>>
         &constraint_generators,
-        bool use_integer_operator_counts, lp::LPSolverType lpsolver,
+        bool use_integer_operator_counts, int constraint_pool_size,
+        int num_threads, lp::LPSolverType lpsolver,
         const std::shared_ptr<AbstractTask> &transform,
         bool cache_estimates, const std::string &description,
         utils::Verbosity verbosity);
+    virtual ~OperatorCountingHeuristic() override;
 };
 }
 
@@ -6,13 +6,17 @@
 #include "../plugins/plugin.h"
 #include "delete_relaxation_if_constraints.h"
 #include "../utils/graphviz.h"
+#include "../utils/thread_pool.h"
+#include "../utils/timer.h"
 #include "../dominance/factor_dominance_relation.h"
 #include "../dominance/label_relation.h"
 #include "../dominance/dominance_analysis.h"
 #include "../dominance/state_dominance_relation.h"
 #include "../factored_transition_system/fact_names.h"
 
+#include <algorithm>
 #include <print>
+#include <span>
 
 #include <boost/algorithm/string/join.hpp>
 
@@ -44,6 +48,41 @@ namespace operator_counting {
         return nfa;
     }
 
+    namespace {
+        struct LabelledTarget {
+            int label;
+            int target;
+            bool relevant;
+
+            auto operator<=>(const LabelledTarget&) const = default;
+        };
+
+        // The outgoing transitions of all states of a factor, one per label, sorted by label in a single buffer
+        class FlatAdjacency {
+            std::vector<int> first_transition;
+            std::vector<LabelledTarget> transitions;
+        public:
+            explicit FlatAdjacency(const fts::LabelledTransitionSystem& lts) {
+                first_transition.reserve(lts.size() + 1);
+                for (int s = 0; s < lts.size(); ++s) {
+                    first_transition.push_back(transitions.size());
+                    for (const auto& tr : lts.get_transitions(s)) {
+                        const bool relevant = lts.is_relevant_label_group(tr.label_group);
+                        for (int label : lts.get_labels(tr.label_group)) {
+                            transitions.emplace_back(label, tr.target, relevant);
+                        }
+                    }
+                    std::sort(transitions.begin() + first_transition.back(), transitions.end());
+                }
+                first_transition.push_back(transitions.size());
+            }
+
+            [[nodiscard]] std::span<const LabelledTarget> get_transitions(int s) const {
+                return std::span<const LabelledTarget>(transitions).subspan(first_transition[s], first_transition[s + 1] - first_transition[s]);
+            }
+        };
+    }
+
     [[nodiscard]] std::pair<mata::nfa::Nfa,std::vector<std::vector<mata::nfa::State>>> construct_transition_response_nfa(int factor, const fts::FTSTask& task, const FactorDominanceRelation& rel, const LabelRelation& label_relation, bool under_approximate) {
         const auto& lts = task.get_factor(factor);
         mata::nfa::Nfa nfa;
@@ -73,81 +112,117 @@ namespace operator_counting {
             }
         }
 
+        const FlatAdjacency adjacency(lts);
+
+        // The label relation is queried once per label instead of once per pair of states and transitions
+        std::vector<int> factor_labels;
+        for (int s = 0; s < lts.size(); ++s) {
+            for (const auto& tr : adjacency.get_transitions(s)) {
+                factor_labels.push_back(tr.label);
+            }
+        }
+        std::ranges::sort(factor_labels);
+        factor_labels.erase(std::unique(factor_labels.begin(), factor_labels.end()), factor_labels.end());
+
+        // dominating_labels[l]: sorted labels of the factor that dominate l in all other factors, for relevant labels l
+        std::vector<std::vector<int>> dominating_labels(lts.get_num_labels());
+        std::vector<bool> noop_dominates(lts.get_num_labels(), false);
+        for (int s_label : factor_labels) {
+            if (!lts.is_relevant_label(s_label)) {
+                continue;
+            }
+            for (int t_label : factor_labels) {
+                if (label_relation.label_dominates_label_in_all_other(factor, task, t_label, s_label)) {
+                    dominating_labels[s_label].push_back(t_label);
+                }
+            }
+            noop_dominates[s_label] = label_relation.noop_dominates_label_in_all_other(factor, task, s_label);
+        }
+
+        mata::nfa::StateSet t_targets;
         for (int t = 0; t < lts.size(); ++t) {
+            const auto t_transitions = adjacency.get_transitions(t);
             for (int s = 0; s < lts.size(); ++s) {
                 if (state_pair_to_nfa_state[s][t] != universally_true) {
-                    const auto& s_transitions = lts.get_transitions(s);
-                    const auto& t_transitions = lts.get_transitions(t);
-                    std::unordered_set<int> unused_labels(all_labels.begin(), all_labels.end());
+                    const auto s_transitions = adjacency.get_transitions(s);
+                    // Labels without s-transition, which are found between the sorted labels of the s-transitions
+                    int next_unused_label = 0;
                     for (const auto& s_tr : s_transitions) {
-                        if (!lts.is_relevant_label_group(s_tr.label_group)) {
-                            for (auto l : lts.get_labels(s_tr.label_group)) {
-                                unused_labels.erase(l);
-                                nfa.delta.add(state_pair_to_nfa_state[s][t], l, universally_true);
-                            }
+                        for (; next_unused_label < s_tr.label; ++next_unused_label) {
+                            // If there is no s-transition for a label, t can trivially simulate it
+                            nfa.delta.add(state_pair_to_nfa_state[s][t], next_unused_label, universally_true);
+                        }
+                        next_unused_label = s_tr.label + 1;
+
+                        if (!s_tr.relevant) {
+                            nfa.delta.add(state_pair_to_nfa_state[s][t], s_tr.label, universally_true);
                             continue;
                         }
 
-                        for (auto s_label : lts.get_labels(s_tr.label_group)) {
-                            unused_labels.erase(s_label);
-                            mata::nfa::StateSet t_targets;
-                            for (const auto t_tr : t_transitions) {
-                                for (auto t_label : lts.get_labels(t_tr.label_group)) {
-                                    if (label_relation.label_dominates_label_in_all_other(factor, task, t_label, s_label)) {
-                                        t_targets.insert(state_pair_to_nfa_state.at(s_tr.target).at(t_tr.target));
-                                    }
-                                }
+                        const auto s_label = s_tr.label;
+                        t_targets.clear();
+                        // Both lists are sorted by label
+                        const auto& dominating = dominating_labels[s_label];
+                        auto dominating_it = dominating.begin();
+                        for (const auto& t_tr : t_transitions) {
+                            while (dominating_it != dominating.end() && *dominating_it < t_tr.label) {
+                                ++dominating_it;
                             }
-
-                            if (label_relation.noop_dominates_label_in_all_other(factor, task, s_label)) {
-                                t_targets.insert(state_pair_to_nfa_state.at(s_tr.target).at(t));
+                            if (dominating_it == dominating.end()) {
+                                break;
+                            }
+                            if (*dominating_it == t_tr.label) {
+                                t_targets.insert(state_pair_to_nfa_state[s_tr.target][t_tr.target]);
                             }
+                        }
 
-                            if (t_targets.empty()) {
-                                // No t-responses, add a transition to universally false
-                                nfa.delta.add(state_pair_to_nfa_state[s][t], s_label, universally_false);
-                            } else if (t_targets.contains(universally_true)) {
-                                // If there is a t-response to a state that simulates s', only add that transition as it is better than the others
-                                nfa.delta.add(state_pair_to_nfa_state[s][t], s_label, universally_true);
-                            } else {
-                                if (under_approximate) {
-                                    /* We can only pick one response of t, so we should try and pick the best one, i.e. the one that simulates most plans of s
-                                     * Prefer final states
-                                     * Prefer states where more transitions lead to universally true
-                                     */
-                                    mata::nfa::State best_target = *t_targets.begin();
-                                    double best_target_score = 0.0;
-                                    for (const auto& target : t_targets) {
-                                        size_t total_transitions = 0;
-                                        size_t transitions_to_true = 0;
-                                        size_t transitions_to_false = 0;
-                                        for (auto sp : nfa.delta.state_post(target)) {
-                                            for (auto tt : sp) {
-                                                if (tt == universally_true) {
-                                                    ++transitions_to_true;
-                                                } else if (tt == universally_false) {
-                                                    ++transitions_to_false;
-                                                }
+                        if (noop_dominates[s_label]) {
+                            t_targets.insert(state_pair_to_nfa_state[s_tr.target][t]);
+                        }
+
+                        if (t_targets.empty()) {
+                            // No t-responses, add a transition to universally false
+                            nfa.delta.add(state_pair_to_nfa_state[s][t], s_label, universally_false);
+                        } else if (t_targets.contains(universally_true)) {
+                            // If there is a t-response to a state that simulates s', only add that transition as it is better than the others
+                            nfa.delta.add(state_pair_to_nfa_state[s][t], s_label, universally_true);
+                        } else {
+                            if (under_approximate) {
+                                /* We can only pick one response of t, so we should try and pick the best one, i.e. the one that simulates most plans of s
+                                 * Prefer final states
+                                 * Prefer states where more transitions lead to universally true
+                                 */
+                                mata::nfa::State best_target = *t_targets.begin();
+                                double best_target_score = 0.0;
+                                for (const auto& target : t_targets) {
+                                    size_t total_transitions = 0;
+                                    size_t transitions_to_true = 0;
+                                    size_t transitions_to_false = 0;
+                                    for (auto sp : nfa.delta.state_post(target)) {
+                                        for (auto tt : sp) {
+                                            if (tt == universally_true) {
+                                                ++transitions_to_true;
+                                            } else if (tt == universally_false) {
+                                                ++transitions_to_false;
                                             }
-                                            ++total_transitions;
                                         }
+                                        ++total_transitions;
+                                    }
 
-                                        double target_score = ((double)(transitions_to_true - transitions_to_false) / total_transitions) + (nfa.final.contains(target)? 100.0: 0.0);
-                                        if (target_score > best_target_score) {
-                                            best_target = target;
-                                            best_target_score = target_score;
-                                        }
+                                    double target_score = ((double)(transitions_to_true - transitions_to_false) / total_transitions) + (nfa.final.contains(target)? 100.0: 0.0);
+                                    if (target_score > best_target_score) {
+                                        best_target = target;
+                                        best_target_score = target_score;
                                     }
-                                    nfa.delta.add(state_pair_to_nfa_state[s][t], s_label, best_target);
-                                } else {
-                                    nfa.delta.add(state_pair_to_nfa_state[s][t], s_label, t_targets);
                                 }
+                                nfa.delta.add(state_pair_to_nfa_state[s][t], s_label, best_target);
+                            } else {
+                                nfa.delta.add(state_pair_to_nfa_state[s][t], s_label, t_targets);
                             }
                         }
                     }
-                    for (const auto& label : unused_labels) {
-                        // If there is no s-transition for a label, t can trivially simulate it
-                        nfa.delta.add(state_pair_to_nfa_state[s][t], label, universally_true);
+                    for (; next_unused_label < lts.get_num_labels(); ++next_unused_label) {
+                        nfa.delta.add(state_pair_to_nfa_state[s][t], next_unused_label, universally_true);
                     }
                 }
             }
@@ -305,16 +380,23 @@ namespace operator_counting {
 
         std::println("Number of simulations: ", factored_domrel->num_simulations());
         std::println("Percentage simulations: ", factored_domrel->get_percentage_simulations(false));
-
-        // Create all the LP variables
-        for (size_t i = 0; i < factored_domrel->size(); ++i) {
+        previous_states = std::make_unique<DominanceCandidateIndex>(*factored_domrel);
+
+        // Construct and minimize the automata of all factors, which only read the task and the dominance relation
+        const size_t num_factors = factored_domrel->size();
+        std::vector<mata::nfa::Nfa> automata(num_factors);
+        std::vector<std::vector<std::vector<mata::nfa::State>>> factor_state_pair_to_nfa_state(num_factors);
+        std::vector<size_t> num_states_before_minimization(num_factors);
+        std::vector<double> construction_time(num_factors);
+        auto construct_factor_automaton = [&](int i) {
+            utils::Timer timer;
             const auto& lts = transformed_task->fts_task->get_factor(i);
             auto [automaton, local_state_pair_to_nfa_state] = construct_transition_response_nfa(i, *transformed_task->fts_task, (*factored_domrel)[i], factored_domrel->get_label_relation(), approximate_determinization);
 #ifndef NDEBUG
             draw_nfa(std::format("nfa_premin_{}.dot", i), automaton, lts, local_state_pair_to_nfa_state);
 #endif
+            num_states_before_minimization[i] = automaton.num_of_states();
             if (minimize_nfa) {
-                std::println("Automaton size before minimization for factor {}: {}", i, automaton.num_of_states());
                 auto [minimal_automaton, state_to_reduced_map] = dominance::merge_non_differentiable_states(automaton, approximate_determinization);
                 for (int s = 0; s < lts.size(); ++s) {
                     for (int t = 0; t < lts.size(); ++t) {
@@ -330,8 +412,29 @@ namespace operator_counting {
                 }
                 automaton.swap_final_nonfinal(); // Swap final and non-final states; nfa should be deterministic and complete
             }
-            std::println("Automaton size for factor {}: {}", i, automaton.num_of_states());
-            state_pair_to_nfa_state.push_back(local_state_pair_to_nfa_state);
+            automata[i] = std::move(automaton);
+            factor_state_pair_to_nfa_state[i] = std::move(local_state_pair_to_nfa_state);
+            construction_time[i] = timer();
+        };
+        if (num_threads > 1) {
+            std::println("Constructing the automata with {} threads", num_threads);
+            utils::ThreadPool pool(num_threads);
+            pool.parallel_for(static_cast<int>(num_factors), construct_factor_automaton);
+        } else {
+            for (size_t i = 0; i < num_factors; ++i) {
+                construct_factor_automaton(i);
+            }
+        }
+
+        state_pair_to_nfa_state = std::move(factor_state_pair_to_nfa_state);
+
+        // Create all the LP variables
+        for (size_t i = 0; i < num_factors; ++i) {
+            const auto& lts = transformed_task->fts_task->get_factor(i);
+            auto& automaton = automata[i];
+            const auto& local_state_pair_to_nfa_state = state_pair_to_nfa_state[i];
+            std::println("Automaton size for factor {}: {} ({} before minimization, {} LTS states), constructed in {:.3f}s",
+                         i, automaton.num_of_states(), num_states_before_minimization[i], lts.size(), construction_time[i]);
 
 #ifndef NDEBUG
             draw_nfa(std::format("nfa_{}.dot", i), automaton, lts, local_state_pair_to_nfa_state);
@@ -398,59 +501,48 @@ namespace operator_counting {
 #endif
         }
 
-        // The constraints for each previous state, the set of initial states for each factor such that one of them must
-        // reach a goal state to satisfy the constraint.
-        std::vector<std::vector<mata::nfa::State>> init_state_constraints;
-
-        for (const auto& previous_state : previous_states) {
-            if (previous_state.g_value <= g_value) {
-                std::vector<mata::nfa::State> initial_states;
-                bool same_state = previous_state.g_value == g_value;
-                size_t num_dominations = 0;
-                for (size_t i = 0; i < previous_state.state.size(); ++i) {
-                    // auto fvn = (*factored_qdomrel)[i].fact_value_names;
-                    if (factored_domrel->get_local_relations()[i]->simulates(previous_state.state[i], explicit_state[i]))
-                        num_dominations += 1;
-#ifndef NDEBUG
-                    std::cout << "    Adding " << state_pair_to_nfa_state.at(i).at(explicit_state[i]).at(previous_state.state[i]) << ": " << transformed_task->fts_task->get_factor(i).state_name(explicit_state[i]) << " <= " << transformed_task->fts_task->get_factor(i).state_name(previous_state.state[i]) << std::endl;
-#endif
-                    initial_states.push_back(state_pair_to_nfa_state.at(i).at(explicit_state[i]).at(previous_state.state[i]));
-                    same_state &= explicit_state[i] == previous_state.state[i];
-                }
-                if (same_state) {
-                    std::println("Break");
-                    // If the state is the same as the previous state, stop here, as we cannot allow comparing against
-                    // nodes that are later or equal in the evaluation order.
-                    break;
-                }
-                if (num_dominations == factored_domrel->size()) {
-                    // If all factors dominate the previous state, then we can prune this state
-                    return true;
-                } if (num_dominations == factored_domrel->size() - 1) {
-                    init_state_constraints.emplace_back(initial_states);
-                }
+        if (previous_states->find_candidates(explicit_state, g_value, candidates)) {
+            // If all factors dominate a previous state, then we can prune this state
+            return true;
+        }
+
+        if (static_cast<int>(candidates.size()) > max_constraints) {
+            switch (candidate_order) {
+            case CandidateOrder::OLDEST:
+                break;
+            case CandidateOrder::NEWEST:
+                std::ranges::reverse(candidates);
+                break;
+            case CandidateOrder::LOWEST_G:
+                std::ranges::stable_sort(candidates, std::less<>(), [&](int id) { return previous_states->get_g_value(id); });
+                break;
+            case CandidateOrder::HIGHEST_G:
+                std::ranges::stable_sort(candidates, std::greater<>(), [&](int id) { return previous_states->get_g_value(id); });
+                break;
             }
+            candidates.resize(max_constraints);
         }
 
-        if (!init_state_constraints.empty()) {
-            // For each set of constraints
-            for (size_t i = 0; i < init_state_constraints.size(); ++i) {
-                // Add initial state constraints
-                lp::LPConstraint constraint(1., lp_solver.get_infinity());
-                for (size_t j = 0; j < init_state_constraints.at(i).size(); ++j) {
-                    // Each initial state should appear with coefficient |constraints|
-                    constraint.insert(init_variables.at(j).at(init_state_constraints.at(i).at(j)), 1.);
-                }
-                lp_constraints.push_back(constraint);
+        // For each previous state that dominates in all factors but one, one of the factors must reach a goal state
+        // from the initial state of the automaton that represents the pair of states
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            std::span<const int> previous_state = previous_states->get_state(candidates[i]);
+            lp::LPConstraint constraint(1., lp_solver.get_infinity());
+            for (size_t j = 0; j < previous_state.size(); ++j) {
 #ifndef NDEBUG
-                lp_constraints.set_name(lp_constraints.size() - 1, std::format("InitStateConstraint[{}]", i));
+                std::cout << "    Adding " << state_pair_to_nfa_state.at(j).at(explicit_state[j]).at(previous_state[j]) << ": " << transformed_task->fts_task->get_factor(j).state_name(explicit_state[j]) << " <= " << transformed_task->fts_task->get_factor(j).state_name(previous_state[j]) << std::endl;
 #endif
+                constraint.insert(init_variables.at(j).at(state_pair_to_nfa_state.at(j).at(explicit_state[j]).at(previous_state[j])), 1.);
             }
+            lp_constraints.push_back(constraint);
+#ifndef NDEBUG
+            lp_constraints.set_name(lp_constraints.size() - 1, std::format("InitStateConstraint[{}]", i));
+#endif
         }
 
         lp_solver.add_temporary_constraints(lp_constraints);
 
-        previous_states.emplace_back(explicit_state, g_value);
+        previous_states->insert(explicit_state, g_value);
         return false;
     }
 
@@ -465,15 +557,28 @@ namespace operator_counting {
             add_option<bool>("only_pruning", "Only use dominance to assign h=∞", "false");
             add_option<bool>("minimize_nfa", "Minimize the NFA before adding it to the LP", "true");
             add_option<bool>("approx_det", "Under-approximate the determinization of the transition response NA", "false");
+            add_option<int>("max_constraints", "Maximum number of previous states used to add constraints in each evaluation", "infinity", plugins::Bounds("0", "infinity"));
+            add_option<CandidateOrder>("candidate_order", "Which previous states are used first if there are more than max_constraints", "oldest");
+            add_option<int>("threads", "Number of threads used to construct and minimize the automata of the factors concurrently", "1", plugins::Bounds("1", "infinity"));
         }
 
         [[nodiscard]] std::shared_ptr<QualifiedDominanceConstraints> create_component(const plugins::Options &opts) const override {
             return std::make_shared<QualifiedDominanceConstraints>(opts.get<std::shared_ptr<DominanceAnalysis>>("dominance"),
                 opts.get<bool>("only_pruning"),
                 opts.get<bool>("minimize_nfa"),
-                opts.get<bool>("approx_det"));
+                opts.get<bool>("approx_det"),
+                opts.get<int>("max_constraints"),
+                opts.get<CandidateOrder>("candidate_order"),
+                opts.get<int>("threads"));
         }
     };
 
     static plugins::FeaturePlugin<QualifiedDominanceConstraintsFeature> _plugin;
+
+    static plugins::TypedEnumPlugin<CandidateOrder> _enum_plugin({
+        {"oldest", "previous states evaluated first"},
+        {"newest", "previous states evaluated last"},
+        {"lowest_g", "previous states with lowest g value"},
+        {"highest_g", "previous states with highest g value"}
+    });
 }
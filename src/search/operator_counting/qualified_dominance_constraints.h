@@ -2,8 +2,11 @@
 #define QUALIFIED_DOMINANCE_CONSTRAINTS_H
 
 #include "constraint_generator.h"
+#include "dominance_candidate_index.h"
 #include "../lp/lp_solver.h"
 
+#include <limits>
+
 #include <mata/nfa/nfa.hh>
 
 namespace dominance {
@@ -22,6 +25,14 @@ namespace dom {
 }
 
 namespace operator_counting {
+    // Which previous states are used first when there are more candidates than max_constraints
+    enum class CandidateOrder {
+        OLDEST,
+        NEWEST,
+        LOWEST_G,
+        HIGHEST_G
+    };
+
     class QualifiedDominanceConstraints final : public ConstraintGenerator {
     public:
         void add_automaton_to_lp(const mata::nfa::Nfa& automaton, lp::LinearProgram& lp, mata::nfa::State state,
@@ -34,19 +45,22 @@ namespace operator_counting {
         bool only_pruning;
         bool minimize_nfa;
         bool approximate_determinization;
+        // Maximum number of previous states used to add constraints in each evaluation
+        int max_constraints;
+        CandidateOrder candidate_order;
+        int num_threads;
 
 
-        explicit QualifiedDominanceConstraints(std::shared_ptr<dominance::DominanceAnalysis> dominance_analysis, const bool only_pruning = false, const bool minimize_nfa = true, const bool approximate_determinization = false) : dominance_analysis(std::move(dominance_analysis)), only_pruning(only_pruning), minimize_nfa(minimize_nfa), approximate_determinization(approximate_determinization)
+        explicit QualifiedDominanceConstraints(std::shared_ptr<dominance::DominanceAnalysis> dominance_analysis, const bool only_pruning = false, const bool minimize_nfa = true, const bool approximate_determinization = false, const int max_constraints = std::numeric_limits<int>::max(), const CandidateOrder candidate_order = CandidateOrder::OLDEST, const int num_threads = 1) : dominance_analysis(std::move(dominance_analysis)), only_pruning(only_pruning), minimize_nfa(minimize_nfa), approximate_determinization(approximate_determinization), max_constraints(max_constraints), candidate_order(candidate_order), num_threads(num_threads)
         {}
 
     private:
         std::unique_ptr<fts::TransformedFTSTask> transformed_task;
         std::unique_ptr<dominance::StateDominanceRelation> factored_domrel = nullptr;
-        struct GValuedState {
-            std::vector<int> state;
-            int g_value;
-        };
-        std::vector<GValuedState> previous_states;
+        // Previous states, indexed by the factors in which they simulate a new state
+        std::unique_ptr<DominanceCandidateIndex> previous_states;
+        // Ids of the previous states used to add constraints, reused across evaluations
+        std::vector<int> candidates;
 
         // For factor i, the map from state s, t to the state in the automaton that represents that t simulates s
         std::vector<std::vector<std::vector<mata::nfa::State>>> state_pair_to_nfa_state;
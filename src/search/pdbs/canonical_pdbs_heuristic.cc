@@ -17,7 +17,8 @@ namespace pdbs {
 static CanonicalPDBs get_canonical_pdbs(
     const shared_ptr<AbstractTask> &task,
     const shared_ptr<PatternCollectionGenerator> &pattern_generator,
-    double max_time_dominance_pruning, utils::LogProxy &log) {
+    double max_time_dominance_pruning, int num_threads,
+    size_t pdb_memory_budget, utils::LogProxy &log) {
     utils::Timer timer;
     if (log.is_at_least_normal()) {
         log << "Initializing canonical PDB heuristic..." << endl;
@@ -31,7 +32,8 @@ static CanonicalPDBs get_canonical_pdbs(
       computed before) so that their computation is not taken into account
       for dominance pruning time.
     */
-    shared_ptr<PDBCollection> pdbs = pattern_collection_info.get_pdbs();
+    shared_ptr<PDBCollection> pdbs = pattern_collection_info.get_pdbs(
+        num_threads, pdb_memory_budget);
     shared_ptr<vector<PatternClique>> pattern_cliques =
         pattern_collection_info.get_pattern_cliques();
 
@@ -62,13 +64,15 @@ static CanonicalPDBs get_canonical_pdbs(
 
 CanonicalPDBsHeuristic::CanonicalPDBsHeuristic(
     const shared_ptr<PatternCollectionGenerator> &patterns,
-    double max_time_dominance_pruning,
+    double max_time_dominance_pruning, int num_threads,
+    size_t pdb_memory_budget,
     const shared_ptr<AbstractTask> &transform, bool cache_estimates,
     const string &description, utils::Verbosity verbosity)
     : Heuristic(transform, cache_estimates, description, verbosity),
       canonical_pdbs(
           get_canonical_pdbs(
-              task, patterns, max_time_dominance_pruning, log)) {
+              task, patterns, max_time_dominance_pruning, num_threads,
+              pdb_memory_budget, log)) {
 }
 
 int CanonicalPDBsHeuristic::compute_heuristic(const State &ancestor_state) {
@@ -116,6 +120,7 @@ public:
             "pattern generation method",
             "systematic(1)");
         add_canonical_pdbs_options_to_feature(*this);
+        add_pdb_construction_options_to_feature(*this);
         add_heuristic_options_to_feature(*this, "cpdbs");
 
         document_language_support("action costs", "supported");
@@ -134,6 +139,7 @@ public:
             opts.get<shared_ptr<PatternCollectionGenerator>>(
                 "patterns"),
             get_canonical_pdbs_arguments_from_options(opts),
+            get_pdb_construction_arguments_from_options(opts),
             get_heuristic_arguments_from_options(opts)
             );
     }
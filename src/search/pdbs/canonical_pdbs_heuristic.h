@@ -22,6 +22,8 @@ public:
     CanonicalPDBsHeuristic(
         const std::shared_ptr<PatternCollectionGenerator> &patterns,
         double max_time_dominance_pruning,
+        int num_threads,
+        size_t pdb_memory_budget,
         const std::shared_ptr<AbstractTask> &transform,
         bool cache_estimates, const std::string &description,
         utils::Verbosity verbosity);
@@ -18,6 +18,7 @@
 #include "../utils/math.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
+#include "../utils/thread_pool.h"
 #include "../utils/timer.h"
 
 #include <algorithm>
@@ -113,7 +114,8 @@ static vector<vector<int>> compute_relevant_neighbours(const TaskProxy &task_pro
 
 PatternCollectionGeneratorHillclimbing::PatternCollectionGeneratorHillclimbing(
     int pdb_max_size, int collection_max_size, int num_samples,
-    int min_improvement, double max_time, int random_seed,
+    int min_improvement, double max_time, int num_threads,
+    size_t pdb_memory_budget, int random_seed,
     utils::Verbosity verbosity)
     : PatternCollectionGenerator(verbosity),
       pdb_max_size(pdb_max_size),
@@ -121,6 +123,8 @@ PatternCollectionGeneratorHillclimbing::PatternCollectionGeneratorHillclimbing(
       num_samples(num_samples),
       min_improvement(min_improvement),
       max_time(max_time),
+      num_threads(num_threads),
+      pdb_memory_budget(pdb_memory_budget),
       rng(utils::get_rng(random_seed)),
       num_rejected(0),
       hill_climbing_timer(nullptr) {
@@ -136,7 +140,7 @@ int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
     PDBCollection &candidate_pdbs) {
     const Pattern &pattern = pdb.get_pattern();
     int pdb_size = pdb.get_size();
-    int max_pdb_size = 0;
+    PatternCollection new_patterns;
     for (int pattern_var : pattern) {
         assert(utils::in_bounds(pattern_var, relevant_neighbours));
         const vector<int> &connected_vars = relevant_neighbours[pattern_var];
@@ -163,16 +167,21 @@ int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
                       surpass the size limit.
                     */
                     generated_patterns.insert(new_pattern);
-                    candidate_pdbs.push_back(
-                        compute_pdb(task_proxy, new_pattern));
-                    max_pdb_size = max(max_pdb_size,
-                                       candidate_pdbs.back()->get_size());
+                    new_patterns.push_back(move(new_pattern));
                 }
             } else {
                 ++num_rejected;
             }
         }
     }
+
+    shared_ptr<PDBCollection> new_pdbs = compute_pdbs(
+        task_proxy, new_patterns, *thread_pool, pdb_memory_budget);
+    int max_pdb_size = 0;
+    for (const shared_ptr<PatternDatabase> &new_pdb : *new_pdbs) {
+        max_pdb_size = max(max_pdb_size, new_pdb->get_size());
+        candidate_pdbs.push_back(new_pdb);
+    }
     return max_pdb_size;
 }
 
@@ -308,6 +317,7 @@ bool PatternCollectionGeneratorHillclimbing::is_heuristic_improved(
 void PatternCollectionGeneratorHillclimbing::hill_climbing(
     const TaskProxy &task_proxy) {
     hill_climbing_timer = new utils::CountdownTimer(max_time);
+    thread_pool = make_unique<utils::ThreadPool>(num_threads);
 
     if (log.is_at_least_normal()) {
         log << "Average operator cost: "
@@ -432,6 +442,7 @@ void PatternCollectionGeneratorHillclimbing::hill_climbing(
 
     delete hill_climbing_timer;
     hill_climbing_timer = nullptr;
+    thread_pool = nullptr;
 }
 
 string PatternCollectionGeneratorHillclimbing::name() const {
@@ -555,10 +566,11 @@ void add_hillclimbing_options_to_feature(plugins::Feature &feature) {
         "spent for pruning dominated patterns.",
         "infinity",
         plugins::Bounds("0.0", "infinity"));
+    add_pdb_construction_options_to_feature(feature);
     utils::add_rng_options_to_feature(feature);
 }
 
-tuple<int, int, int, int, double, int>
+tuple<int, int, int, int, double, int, size_t, int>
 get_hillclimbing_arguments_from_options(const plugins::Options &opts) {
     return tuple_cat(
         make_tuple(
@@ -567,6 +579,7 @@ get_hillclimbing_arguments_from_options(const plugins::Options &opts) {
             opts.get<int>("num_samples"),
             opts.get<int>("min_improvement"),
             opts.get<double>("max_time")),
+        get_pdb_construction_arguments_from_options(opts),
         utils::get_rng_arguments_from_options(opts));
 }
 
@@ -666,7 +679,8 @@ public:
 
         return plugins::make_shared_from_arg_tuples<CanonicalPDBsHeuristic>(
             pgh,
-            opts.get<double>("max_time_dominance_pruning"),
+            get_canonical_pdbs_arguments_from_options(opts),
+            get_pdb_construction_arguments_from_options(opts),
             get_heuristic_arguments_from_options(opts)
             );
     }
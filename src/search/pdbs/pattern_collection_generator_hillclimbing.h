@@ -14,6 +14,7 @@
 namespace utils {
 class CountdownTimer;
 class RandomNumberGenerator;
+class ThreadPool;
 }
 
 namespace sampling {
@@ -35,9 +36,14 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
     // minimal improvement required for hill climbing to continue search
     const int min_improvement;
     const double max_time;
+    // number of threads and shared memory budget for computing candidate PDBs
+    const int num_threads;
+    const size_t pdb_memory_budget;
     std::shared_ptr<utils::RandomNumberGenerator> rng;
 
     std::unique_ptr<IncrementalCanonicalPDBs> current_pdbs;
+    // Computes the candidate PDBs, created once for the whole hill climbing
+    std::unique_ptr<utils::ThreadPool> thread_pool;
 
     // for stats only
     int num_rejected;
@@ -48,7 +54,8 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
       relevant variable are considered as candidate patterns. If the candidate
       pattern has not been previously considered (not contained in
       generated_patterns) and if building a PDB for it does not surpass the
-      size limit, then the PDB is built and added to candidate_pdbs.
+      size limit, then the PDB is built and added to candidate_pdbs. The PDBs
+      of all new candidate patterns are built in parallel (see compute_pdbs).
 
       The method returns the size of the largest PDB added to candidate_pdbs.
     */
@@ -134,13 +141,14 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
 public:
     PatternCollectionGeneratorHillclimbing(
         int pdb_max_size, int collection_max_size, int num_samples,
-        int min_improvement, double max_time, int random_seed,
+        int min_improvement, double max_time, int num_threads,
+        size_t pdb_memory_budget, int random_seed,
         utils::Verbosity verbosity);
 };
 
 extern void add_hillclimbing_options_to_feature(
     plugins::Feature &feature);
-std::tuple<int, int, int, int, double, int>
+std::tuple<int, int, int, int, double, int, size_t, int>
 get_hillclimbing_arguments_from_options(
     const plugins::Options &opts);
 }
@@ -56,19 +56,15 @@ bool PatternCollectionInformation::information_is_valid() const {
     return true;
 }
 
-void PatternCollectionInformation::create_pdbs_if_missing() {
+void PatternCollectionInformation::create_pdbs_if_missing(
+    int num_threads, size_t memory_budget) {
     assert(patterns);
     if (!pdbs) {
         utils::Timer timer;
         if (log.is_at_least_normal()) {
             log << "Computing PDBs for pattern collection..." << endl;
         }
-        pdbs = make_shared<PDBCollection>();
-        for (const Pattern &pattern : *patterns) {
-            shared_ptr<PatternDatabase> pdb =
-                compute_pdb(task_proxy, pattern);
-            pdbs->push_back(pdb);
-        }
+        pdbs = compute_pdbs(task_proxy, *patterns, num_threads, memory_budget);
         if (log.is_at_least_normal()) {
             log << "Done computing PDBs for pattern collection: "
                 << timer << endl;
@@ -108,7 +104,12 @@ shared_ptr<PatternCollection> PatternCollectionInformation::get_patterns() const
 }
 
 shared_ptr<PDBCollection> PatternCollectionInformation::get_pdbs() {
-    create_pdbs_if_missing();
+    return get_pdbs(1, 0);
+}
+
+shared_ptr<PDBCollection> PatternCollectionInformation::get_pdbs(
+    int num_threads, size_t memory_budget) {
+    create_pdbs_if_missing(num_threads, memory_budget);
     return pdbs;
 }
 
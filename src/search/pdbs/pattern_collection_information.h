@@ -31,7 +31,7 @@ class PatternCollectionInformation {
     std::shared_ptr<std::vector<PatternClique>> pattern_cliques;
     utils::LogProxy &log;
 
-    void create_pdbs_if_missing();
+    void create_pdbs_if_missing(int num_threads, size_t memory_budget);
     void create_pattern_cliques_if_missing();
 
     bool information_is_valid() const;
@@ -52,6 +52,11 @@ public:
 
     std::shared_ptr<PatternCollection> get_patterns() const;
     std::shared_ptr<PDBCollection> get_pdbs();
+    /*
+      Like get_pdbs(), but missing PDBs are computed with num_threads threads
+      and a shared memory budget in bytes (see compute_pdbs()).
+    */
+    std::shared_ptr<PDBCollection> get_pdbs(int num_threads, size_t memory_budget);
     std::shared_ptr<std::vector<PatternClique>> get_pattern_cliques();
 };
 }
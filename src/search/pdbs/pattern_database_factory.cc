@@ -8,10 +8,13 @@
 #include "../task_utils/task_properties.h"
 #include "../utils/math.h"
 #include "../utils/rng.h"
+#include "../utils/thread_pool.h"
 
 #include <algorithm>
 #include <cassert>
+#include <condition_variable>
 #include <limits>
+#include <mutex>
 #include <vector>
 
 using namespace std;
@@ -449,4 +452,108 @@ compute_pdb_and_plan(
     PatternDatabaseFactory pdb_factory(task_proxy, pattern, operator_costs, true, rng, compute_wildcard_plan);
     return {pdb_factory.extract_pdb(), pdb_factory.extract_wildcard_plan()};
 }
+
+/*
+  Rough number of bytes needed per abstract state while computing a PDB: the
+  distance table and the generating operators, plus the entries of the
+  priority queue of the Dijkstra search.
+*/
+static const size_t BYTES_PER_ABSTRACT_STATE = 4 * sizeof(int);
+
+static size_t estimate_construction_memory(
+    const TaskProxy &task_proxy, const Pattern &pattern) {
+    // The estimate saturates instead of overflowing.
+    const size_t limit = numeric_limits<size_t>::max() / BYTES_PER_ABSTRACT_STATE;
+    VariablesProxy variables = task_proxy.get_variables();
+    size_t num_states = 1;
+    for (int var : pattern) {
+        size_t domain_size = variables[var].get_domain_size();
+        if (num_states > limit / domain_size) {
+            return numeric_limits<size_t>::max();
+        }
+        num_states *= domain_size;
+    }
+    return num_states * BYTES_PER_ABSTRACT_STATE;
+}
+
+/*
+  Memory shared by the threads that compute PDBs. A thread reserves the
+  memory of a PDB before computing it and waits while the reservation would
+  exceed the budget, unless no memory is reserved at all.
+*/
+class MemoryBudget {
+    const size_t budget;
+    size_t reserved;
+    mutex budget_mutex;
+    condition_variable memory_released;
+public:
+    explicit MemoryBudget(size_t budget)
+        : budget(budget), reserved(0) {
+    }
+
+    void reserve(size_t memory) {
+        unique_lock<mutex> lock(budget_mutex);
+        memory_released.wait(lock, [&]() {
+            return reserved == 0 || (reserved <= budget && memory <= budget - reserved);
+        });
+        reserved += memory;
+    }
+
+    void release(size_t memory) {
+        {
+            lock_guard<mutex> lock(budget_mutex);
+            reserved -= memory;
+        }
+        memory_released.notify_all();
+    }
+};
+
+shared_ptr<PDBCollection> compute_pdbs(
+    const TaskProxy &task_proxy,
+    const PatternCollection &patterns,
+    int num_threads,
+    size_t memory_budget,
+    const vector<int> &operator_costs) {
+    int num_patterns = patterns.size();
+    num_threads = min(num_threads, num_patterns);
+    if (num_threads <= 1) {
+        auto pdbs = make_shared<PDBCollection>(num_patterns);
+        for (int i = 0; i < num_patterns; ++i) {
+            (*pdbs)[i] = compute_pdb(task_proxy, patterns[i], operator_costs);
+        }
+        return pdbs;
+    }
+    utils::ThreadPool thread_pool(num_threads);
+    return compute_pdbs(
+        task_proxy, patterns, thread_pool, memory_budget, operator_costs);
+}
+
+shared_ptr<PDBCollection> compute_pdbs(
+    const TaskProxy &task_proxy,
+    const PatternCollection &patterns,
+    utils::ThreadPool &thread_pool,
+    size_t memory_budget,
+    const vector<int> &operator_costs) {
+    int num_patterns = patterns.size();
+    auto pdbs = make_shared<PDBCollection>(num_patterns);
+
+    /*
+      Each PDB is stored at the index of its pattern, and its computation
+      does not depend on the other PDBs, so the result does not depend on
+      the order in which the threads compute them.
+    */
+    MemoryBudget budget(memory_budget ? memory_budget : numeric_limits<size_t>::max());
+    thread_pool.parallel_for(num_patterns, [&](int i) {
+        size_t memory = estimate_construction_memory(task_proxy, patterns[i]);
+        budget.reserve(memory);
+        try {
+            (*pdbs)[i] = compute_pdb(task_proxy, patterns[i], operator_costs);
+        } catch (...) {
+            budget.release(memory);
+            throw;
+        }
+        budget.release(memory);
+    });
+    return pdbs;
+}
 }
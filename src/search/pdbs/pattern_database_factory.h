@@ -11,6 +11,7 @@
 
 namespace utils {
 class RandomNumberGenerator;
+class ThreadPool;
 }
 
 namespace pdbs {
@@ -29,6 +30,35 @@ extern std::shared_ptr<PatternDatabase> compute_pdb(
     const std::vector<int> &operator_costs = std::vector<int>(),
     const std::shared_ptr<utils::RandomNumberGenerator> &rng = nullptr);
 
+/*
+  Compute the PDBs for all patterns of the collection, using operator_costs as
+  in compute_pdb(). The PDBs are distributed over num_threads threads, and
+  the result is the same for any number of threads.
+
+  memory_budget bounds the memory (in bytes) that may be used by all PDBs
+  under construction at the same time. It is estimated from the number of
+  abstract states of each PDB, and a PDB that exceeds the budget on its own
+  is computed while no other PDB is under construction. A budget of 0 means
+  that the memory is not limited.
+*/
+extern std::shared_ptr<PDBCollection> compute_pdbs(
+    const TaskProxy &task_proxy,
+    const PatternCollection &patterns,
+    int num_threads,
+    size_t memory_budget,
+    const std::vector<int> &operator_costs = std::vector<int>());
+
+/*
+  Same as above, but the PDBs are distributed over the threads of the given
+  pool. This avoids starting new threads when PDBs are computed repeatedly.
+*/
+extern std::shared_ptr<PDBCollection> compute_pdbs(
+    const TaskProxy &task_proxy,
+    const PatternCollection &patterns,
+    utils::ThreadPool &thread_pool,
+    size_t memory_budget,
+    const std::vector<int> &operator_costs = std::vector<int>());
+
 /*
   In addition to computing a PDB for the given task and pattern like
   compute_pdb() above, also compute an abstract plan along.
@@ -52,6 +52,30 @@ tuple<utils::Verbosity> get_generator_arguments_from_options(
     return utils::get_log_arguments_from_options(opts);
 }
 
+void add_pdb_construction_options_to_feature(plugins::Feature &feature) {
+    feature.add_option<int>(
+        "threads",
+        "Number of threads used to compute PDBs concurrently. The PDBs do not "
+        "depend on the number of threads.",
+        "1",
+        plugins::Bounds("1", "infinity"));
+    feature.add_option<int>(
+        "pdb_memory_budget",
+        "Estimated memory in MiB that may be used by all PDBs that are "
+        "computed concurrently. A PDB that exceeds the budget on its own is "
+        "computed while no other PDB is computed. Using 0 does not limit the "
+        "memory.",
+        "0",
+        plugins::Bounds("0", "infinity"));
+}
+
+tuple<int, size_t> get_pdb_construction_arguments_from_options(
+    const plugins::Options &opts) {
+    return make_tuple(
+        opts.get<int>("threads"),
+        static_cast<size_t>(opts.get<int>("pdb_memory_budget")) * 1024 * 1024);
+}
+
 static class PatternCollectionGeneratorCategoryPlugin : public plugins::TypedCategoryPlugin<PatternCollectionGenerator> {
 public:
     PatternCollectionGeneratorCategoryPlugin() : TypedCategoryPlugin("PatternCollectionGenerator") {
@@ -52,6 +52,14 @@ public:
 extern void add_generator_options_to_feature(plugins::Feature &feature);
 extern std::tuple<utils::Verbosity>
 get_generator_arguments_from_options(const plugins::Options &opts);
+
+/*
+  Options for computing several PDBs in parallel with compute_pdbs(). The
+  memory budget is given in MiB on the command line and returned in bytes.
+*/
+extern void add_pdb_construction_options_to_feature(plugins::Feature &feature);
+extern std::tuple<int, size_t>
+get_pdb_construction_arguments_from_options(const plugins::Options &opts);
 }
 
 #endif
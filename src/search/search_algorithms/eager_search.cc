@@ -10,6 +10,7 @@
 #include "../task_utils/successor_generator.h"
 #include "../utils/logging.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <memory>
@@ -34,6 +35,7 @@ EagerSearch::EagerSearch(
       reopen_closed_nodes(reopen_closed),
       open_list(open->create_state_open_list()),
       f_evaluator(f_eval),     // default nullptr
+      use_batch_evaluation(false),
       preferred_operator_evaluators(preferred),
       lazy_evaluator(lazy_evaluator),     // default nullptr
       pruning_method(pruning)
@@ -83,6 +85,8 @@ void EagerSearch::initialize() {
     }
 
     path_dependent_evaluators.assign(evals.begin(), evals.end());
+    use_batch_evaluation = f_evaluator && path_dependent_evaluators.empty() &&
+        f_evaluator->supports_batch_evaluation();
 
     State initial_state = state_registry.get_initial_state();
     for (Evaluator *evaluator : path_dependent_evaluators) {
@@ -218,12 +222,53 @@ SearchStatus EagerSearch::step() {
                                     preferred_operators);
     }
 
-    for (OperatorID op_id : applicable_ops) {
+    /*
+      Evaluate the new successors together before processing them, so that
+      evaluators can share work between them or evaluate them concurrently
+      (see Evaluator::compute_results). This is not possible with
+      path-dependent evaluators, which must be notified of the transition
+      before the successor is evaluated.
+    */
+    vector<optional<State>> successors;
+    vector<EvaluationContext> successor_eval_contexts;
+    vector<int> successor_eval_context_index;
+    if (use_batch_evaluation) {
+        successors.resize(applicable_ops.size());
+        successor_eval_context_index.assign(applicable_ops.size(), -1);
+        for (size_t i = 0; i < applicable_ops.size(); ++i) {
+            OperatorProxy op = task_proxy.get_operators()[applicable_ops[i]];
+            if ((node->get_real_g() + op.get_cost()) >= bound)
+                continue;
+            successors[i] = state_registry.get_successor_state(s, op);
+            const State &succ_state = *successors[i];
+            bool is_duplicate = any_of(
+                successor_eval_contexts.begin(), successor_eval_contexts.end(),
+                [&](const EvaluationContext &eval_context) {
+                    return eval_context.get_state().get_id() == succ_state.get_id();
+                });
+            if (is_duplicate || !search_space.get_node(succ_state).is_new())
+                continue;
+            int succ_g = node->get_g() + get_adjusted_cost(op);
+            successor_eval_context_index[i] = successor_eval_contexts.size();
+            successor_eval_contexts.emplace_back(
+                succ_state, succ_g, preferred_operators.contains(applicable_ops[i]),
+                &statistics);
+        }
+        vector<EvaluationContext *> batch;
+        batch.reserve(successor_eval_contexts.size());
+        for (EvaluationContext &eval_context : successor_eval_contexts)
+            batch.push_back(&eval_context);
+        f_evaluator->compute_results(batch);
+    }
+
+    for (size_t i = 0; i < applicable_ops.size(); ++i) {
+        OperatorID op_id = applicable_ops[i];
         OperatorProxy op = task_proxy.get_operators()[op_id];
         if ((node->get_real_g() + op.get_cost()) >= bound)
             continue;
 
-        State succ_state = state_registry.get_successor_state(s, op);
+        State succ_state = use_batch_evaluation && successors[i] ? *successors[i] :
+            state_registry.get_successor_state(s, op);
         statistics.inc_generated();
         bool is_preferred = preferred_operators.contains(op_id);
 
@@ -251,8 +296,10 @@ SearchStatus EagerSearch::step() {
             */
             int succ_g = node->get_g() + get_adjusted_cost(op);
 
-            EvaluationContext succ_eval_context(
-                succ_state, succ_g, is_preferred, &statistics);
+            EvaluationContext succ_eval_context =
+                use_batch_evaluation && successor_eval_context_index[i] != -1 ?
+                move(successor_eval_contexts[successor_eval_context_index[i]]) :
+                EvaluationContext(succ_state, succ_g, is_preferred, &statistics);
             statistics.inc_evaluated_states();
 #ifndef NDEBUG
             if (succ_eval_context.is_evaluator_value_infinite(f_evaluator.get())) {
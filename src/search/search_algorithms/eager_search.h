@@ -24,6 +24,8 @@ class EagerSearch : public SearchAlgorithm {
     std::shared_ptr<Evaluator> f_evaluator;
 
     std::vector<Evaluator *> path_dependent_evaluators;
+    // Whether the successors of a state are evaluated together with f_evaluator->compute_results
+    bool use_batch_evaluation;
     std::vector<std::shared_ptr<Evaluator>> preferred_operator_evaluators;
     std::shared_ptr<Evaluator> lazy_evaluator;
 
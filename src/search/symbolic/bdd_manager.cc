@@ -8,6 +8,12 @@
 using namespace std;
 using plugins::Options;
 
+// Group types of the variable tree, defined in mtr.h which is not installed with CUDD
+#ifndef MTR_FIXED
+#define MTR_DEFAULT 0x00000000
+#define MTR_FIXED 0x00000004
+#endif
+
 namespace symbolic {
     //Initialize manager
     void exceptionError(string /*message*/) {
@@ -27,10 +33,16 @@ namespace symbolic {
     BDDManagerParameters::BDDManagerParameters(const Options &opts) :
     cudd_init_nodes(opts.get<int>("cudd_init_nodes")),
     cudd_init_cache_size(opts.get<int>("cudd_init_cache_size")),
-    cudd_init_available_memory(opts.get<int>("cudd_init_available_memory")) {
+    cudd_init_available_memory(opts.get<int>("cudd_init_available_memory")),
+    reordering(opts.get<ReorderingMethod>("reordering")),
+    reordering_threshold(opts.get<int>("reordering_threshold")),
+    reordering_growth(opts.get<double>("reordering_growth")),
+    reordering_max_time(opts.get<double>("reordering_max_time")),
+    reordering_max_times(opts.get<int>("reordering_max_times")) {
     }
 
-    BDDManager::BDDManager(const BDDManagerParameters &params) : params(params) {
+    BDDManager::BDDManager(const BDDManagerParameters &params) : params(params),
+        next_reordering_nodes(params.reordering_threshold), num_reorderings(0), reordering_time(0) {
     }
 
     void BDDManager::init(int num_bdd_vars) {
@@ -49,6 +61,44 @@ namespace symbolic {
         _manager->setTimeoutHandler(exceptionError);
         _manager->setNodesExceededHandler(exceptionError);
         _manager->RegisterOutOfMemoryCallback(exitOutOfMemory);
+        // Reordering is only triggered explicitly in reorder_if_needed, never in the middle of an operation
+        _manager->AutodynDisable();
+        if (params.reordering != ReorderingMethod::NONE) {
+            _manager->SetMaxGrowth(params.reordering_growth);
+        }
+    }
+
+    void BDDManager::group_variables(int low, int size, bool fixed) {
+        assert(_manager);
+        if (params.reordering == ReorderingMethod::NONE) {
+            return;
+        }
+        _manager->MakeTreeNode(low, size, fixed ? MTR_FIXED : MTR_DEFAULT);
+    }
+
+    void BDDManager::reorder_if_needed() {
+        if (params.reordering == ReorderingMethod::NONE || num_reorderings >= params.reordering_max_times ||
+            totalNodes() <= next_reordering_nodes) {
+            return;
+        }
+
+        utils::Timer timer;
+        long nodes_before = totalNodes();
+        // Sifting and window permutation stop once the time limit is exceeded, keeping the order found so far
+        if (!params.reordering_max_time.is_infinity()) {
+            setTimeLimit(static_cast<unsigned long>(params.reordering_max_time * 1000));
+        }
+        _manager->ReduceHeap(params.reordering == ReorderingMethod::SIFT ? CUDD_REORDER_SIFT : CUDD_REORDER_WINDOW3, 0);
+        unsetTimeLimit();
+        ++num_reorderings;
+        reordering_time = utils::Duration(reordering_time + timer());
+
+        next_reordering_nodes = max(next_reordering_nodes, static_cast<long>(totalNodes() * params.reordering_growth));
+        if (utils::g_log.is_at_least_normal()) {
+            utils::g_log << "BDD reordering " << num_reorderings << ": " << nodes_before << " => " << totalNodes()
+                         << " nodes in " << timer << ", next at " << next_reordering_nodes << " nodes, total time: "
+                         << reordering_time << endl;
+        }
     }
 
     void BDDManager::add_options_to_feature(plugins::Feature &feature) {
@@ -56,8 +106,25 @@ namespace symbolic {
         feature.add_option<int>("cudd_init_cache_size", "Initial number of cache entries in the cudd manager.",
                                 "16000000");
         feature.add_option<int>("cudd_init_available_memory", "Total available memory for the cudd manager.", "0");
+        feature.add_option<ReorderingMethod>("reordering", "Dynamic reordering of the BDD variables.", "none");
+        feature.add_option<int>("reordering_threshold", "Number of nodes that triggers the first reordering.",
+                                "1000000", plugins::Bounds("1", "infinity"));
+        feature.add_option<double>("reordering_growth",
+                                   "After a reordering, the next one is triggered when the number of nodes grows by "
+                                   "this factor. Also bounds the growth allowed while sifting a variable.", "2",
+                                   plugins::Bounds("1", "infinity"));
+        feature.add_option<double>("reordering_max_time", "Maximum time (s) of each reordering.", "10",
+                                   plugins::Bounds("0", "infinity"));
+        feature.add_option<int>("reordering_max_times", "Maximum number of reorderings.", "infinity",
+                                plugins::Bounds("0", "infinity"));
     }
 
+    static plugins::TypedEnumPlugin<ReorderingMethod> _enum_plugin({
+        {"none", "fixed variable ordering"},
+        {"sift", "sifting of groups of variables"},
+        {"window", "permutations of windows of three groups of variables"}
+    });
+
     ADD BDDManager::getADD(const std::map<int, BDD> &heur) {
         ADD total = mgr()->plusInfinity();
 
@@ -74,6 +141,11 @@ namespace symbolic {
         cout << "CUDD Init: nodes=" << params.cudd_init_nodes <<
              " cache=" << params.cudd_init_cache_size <<
              " max_memory=" << params.cudd_init_available_memory << endl;
+        if (params.reordering != ReorderingMethod::NONE) {
+            cout << "BDD reordering: " << (params.reordering == ReorderingMethod::SIFT ? "sift" : "window") <<
+                 " threshold=" << params.reordering_threshold << " growth=" << params.reordering_growth <<
+                 " max_time=" << params.reordering_max_time << " max_times=" << params.reordering_max_times << endl;
+        }
     }
 
     bool BDDManager::perform_operation_with_time_limit(utils::Duration maxTime, const std::function<void()> &function) {
@@ -83,6 +155,7 @@ namespace symbolic {
             try {
                 function();
                 unsetTimeLimit();
+                reorder_if_needed();
                 return true;
             } catch (BDDError e) {
                 unsetTimeLimit();
@@ -91,6 +164,7 @@ namespace symbolic {
         } else {
             try {
                 function();
+                reorder_if_needed();
                 return true;
             } catch (BDDError e) {
                 return false;
@@ -106,6 +180,7 @@ namespace symbolic {
             try {
                 BDD result = function();
                 unsetTimeLimit();
+                reorder_if_needed();
                 return result;
             } catch (BDDError e) {
                 unsetTimeLimit();
@@ -114,6 +189,7 @@ namespace symbolic {
         } else {
             try {
                 BDD result = function();
+                reorder_if_needed();
                 return result;
             } catch (BDDError e) {
                 return std::nullopt;
@@ -24,18 +24,31 @@ namespace symbolic {
 
     extern void exitOutOfMemory(size_t memory);
 
+    enum class ReorderingMethod {
+        NONE, SIFT, WINDOW
+    };
+
     struct BDDManagerParameters {
         //Parameters to initialize the CUDD manager
         const long cudd_init_nodes; //Number of initial nodes
         const long cudd_init_cache_size; //Initial cache size
         const long cudd_init_available_memory; //Maximum available memory (bytes)
 
+        //Parameters of dynamic variable reordering
+        const ReorderingMethod reordering;
+        const long reordering_threshold; //Number of nodes that triggers the first reordering
+        const double reordering_growth; //Factor over the nodes after a reordering that triggers the next one
+        const utils::Duration reordering_max_time; //Time budget of each reordering
+        const int reordering_max_times; //Maximum number of reorderings
+
         BDDManagerParameters(const plugins::Options &opts);
 
         BDDManagerParameters(long cudd_init_nodes, long cudd_init_cache_size, long cudd_init_available_memory) :
                 cudd_init_nodes(cudd_init_nodes),
                 cudd_init_cache_size(cudd_init_cache_size),
-                cudd_init_available_memory(cudd_init_available_memory) {
+                cudd_init_available_memory(cudd_init_available_memory),
+                reordering(ReorderingMethod::NONE), reordering_threshold(0), reordering_growth(0),
+                reordering_max_time(0), reordering_max_times(0) {
         }
     };
 
@@ -44,6 +57,10 @@ namespace symbolic {
 
         std::unique_ptr<Cudd> _manager; //_manager associated with this symbolic search
 
+        long next_reordering_nodes; //Number of nodes that triggers the next reordering
+        int num_reorderings;
+        utils::Duration reordering_time;
+
         void setTimeLimit(unsigned long maxTime) {
             _manager->SetTimeLimit(maxTime);
             _manager->ResetStartTime();
@@ -59,6 +76,14 @@ namespace symbolic {
 
         void init(int num_bdd_vars);
 
+        // Keeps the BDD variables [low, low + size) together when reordering. If fixed, their relative order is
+        // kept as well (e.g. to keep each variable next to its primed copy).
+        void group_variables(int low, int size, bool fixed);
+
+        // Reorders the variables if reordering is enabled and the number of nodes exceeds the current threshold.
+        // Must be called outside of BDD operations; the indices of the variables do not change.
+        void reorder_if_needed();
+
 
         // Functions to add a global time limit to all BDD operations within function.
         // If time limit is exceeded, it returns false.
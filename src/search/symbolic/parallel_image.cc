@@ -0,0 +1,70 @@
+#include "parallel_image.h"
+
+#include "bdd_manager.h"
+#include "transition_relation.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace symbolic {
+    ParallelImage::ParallelImage(int num_workers, const Cudd &main_manager) : thread_pool(num_workers) {
+        workers.resize(num_workers);
+        for (Worker &worker : workers) {
+            worker.manager = make_unique<Cudd>(main_manager.ReadSize(), 0);
+            worker.manager->setHandler(exceptionError);
+            worker.manager->setTimeoutHandler(exceptionError);
+            worker.manager->setNodesExceededHandler(exceptionError);
+            worker.manager->RegisterOutOfMemoryCallback(exitOutOfMemory);
+        }
+    }
+
+    ParallelImage::~ParallelImage() = default;
+
+    const TransitionRelation &ParallelImage::get_transition_relation(Worker &worker, const TransitionRelation &tr) {
+        auto &transferred = worker.transition_relations[&tr];
+        if (!transferred) {
+            transferred = make_unique<TransitionRelation>(tr.transfer(*worker.manager));
+        }
+        return *transferred;
+    }
+
+    vector<optional<BDD>> ParallelImage::image(bool fw, const vector<BDD> &states,
+                                               const vector<const TransitionRelation *> &transition_relations,
+                                               Cudd &main_manager, utils::Duration maxTime, long maxNodes) {
+        assert(states.size() == transition_relations.size());
+        assert(states.size() <= workers.size());
+        const int num_images = states.size();
+
+        // Transfers are done sequentially, as they read the main manager
+        vector<BDD> worker_states;
+        vector<const TransitionRelation *> worker_transition_relations;
+        for (int i = 0; i < num_images; ++i) {
+            worker_states.push_back(states[i].Transfer(*workers[i].manager));
+            worker_transition_relations.push_back(&get_transition_relation(workers[i], *transition_relations[i]));
+        }
+
+        vector<optional<BDD>> worker_images(num_images);
+        thread_pool.parallel_for(num_images, [&](int i) {
+            Cudd &manager = *workers[i].manager;
+            if (!maxTime.is_infinity()) {
+                manager.SetTimeLimit(static_cast<unsigned long>(maxTime * 1000));
+                manager.ResetStartTime();
+            }
+            try {
+                worker_images[i] = worker_transition_relations[i]->image(fw, worker_states[i], maxNodes);
+            } catch (BDDError &) {
+                worker_images[i] = nullopt;
+            }
+            manager.UnsetTimeLimit();
+        });
+
+        vector<optional<BDD>> result(num_images);
+        for (int i = 0; i < num_images; ++i) {
+            if (worker_images[i]) {
+                result[i] = worker_images[i]->Transfer(main_manager);
+            }
+        }
+        return result;
+    }
+}
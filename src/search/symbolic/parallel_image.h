@@ -0,0 +1,52 @@
+#ifndef SYMBOLIC_PARALLEL_IMAGE_H
+#define SYMBOLIC_PARALLEL_IMAGE_H
+
+#include "cuddObj.hh"
+
+#include "../utils/thread_pool.h"
+#include "../utils/timer.h"
+
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace symbolic {
+    class TransitionRelation;
+
+    /*
+     * Computes several images concurrently. CUDD managers are not thread-safe, so each worker has its own manager
+     * with the same variables as the main manager. The transition relations are transferred to each worker once and
+     * cached. The sets of states and the resulting images are transferred between the managers by the calling
+     * thread, so only the image computations run in parallel.
+     */
+    class ParallelImage {
+        struct Worker {
+            // Declared first, so that the BDDs below are released before the manager
+            std::unique_ptr<Cudd> manager;
+            std::unordered_map<const TransitionRelation *, std::unique_ptr<TransitionRelation>> transition_relations;
+        };
+
+        std::vector<Worker> workers;
+        utils::ThreadPool thread_pool;
+
+        const TransitionRelation &get_transition_relation(Worker &worker, const TransitionRelation &tr);
+    public:
+        ParallelImage(int num_workers, const Cudd &main_manager);
+        ~ParallelImage();
+
+        int get_num_workers() const {
+            return workers.size();
+        }
+
+        /*
+         * Returns the image of states[i] under transition_relations[i] in the main manager, or nothing if it could
+         * not be computed within maxTime and maxNodes. At most get_num_workers() images are computed at once.
+         */
+        std::vector<std::optional<BDD>> image(bool fw, const std::vector<BDD> &states,
+                                              const std::vector<const TransitionRelation *> &transition_relations,
+                                              Cudd &main_manager, utils::Duration maxTime, long maxNodes);
+    };
+}
+
+#endif
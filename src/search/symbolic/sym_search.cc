@@ -33,6 +33,7 @@ namespace symbolic {
             ratioAllottedTime(opts.get<double>("ratio_allotted_time")),
             ratioAllottedNodes(opts.get<double>("ratio_allotted_nodes")),
             non_stop(opts.get<bool>("non_stop")),
+            image_threads(opts.get<int>("image_threads")),
             log(utils::get_log_for_verbosity(std::get<0>(utils::get_log_arguments_from_options(opts)))) {
         print_options();
     }
@@ -49,6 +50,7 @@ namespace symbolic {
             log << "   Max allotted time: " << maxAllottedTime << " nodes: " << maxAllottedNodes << endl;
             log << "   Mult allotted time: " << ratioAllottedTime << " nodes: " << ratioAllottedNodes << endl;
             log << "Non stop: " << non_stop << endl;
+            log << "Image threads: " << image_threads << endl;
         }
     }
 
@@ -84,6 +86,12 @@ namespace symbolic {
         feature.add_option<bool>("non_stop",
                                  "Removes initial state from closed to avoid backward search to stop.",
                                  "false");
+
+        feature.add_option<int>("image_threads",
+                                "number of images with the same resulting cost that are computed concurrently. "
+                                "Each thread uses its own CUDD manager, and the BDDs are transferred between the "
+                                "managers.",
+                                "1", plugins::Bounds("1", "infinity"));
     }
 
     int SymParamsSearch::getMaxStepNodes() const {
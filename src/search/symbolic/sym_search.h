@@ -48,6 +48,9 @@ namespace symbolic {
 
         bool non_stop;
 
+        // Number of images computed concurrently, each in a separate CUDD manager
+        int image_threads;
+
         mutable utils::LogProxy log;
 
         SymParamsSearch(const plugins::Options &opts);
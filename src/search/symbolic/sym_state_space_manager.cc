@@ -52,6 +52,24 @@ void SymStateSpaceManager::shrinkBucket(Bucket &bucket, int maxNodes) {
             merge(vars->get_bdd_manager(), entry.second, merge_uniqueTR, p.max_tr_time, p.max_tr_size);
         }
 
+        if (p.tr_type == TransitionRelationType::CONJUNCTIVE) {
+            // Only TRs that could not be merged with others keep their conjuncts. The individual TRs are shared
+            // with the plan reconstruction, so they are copied before partitioning them.
+            int num_partitioned = 0;
+            for (auto &entry: transitions) {
+                for (auto &tr: entry.second) {
+                    auto partitioned = make_shared<TransitionRelation>(*tr);
+                    if (partitioned->partition(p.max_partition_size)) {
+                        tr = partitioned;
+                        ++num_partitioned;
+                    }
+                }
+            }
+            if (utils::g_log.is_at_least_verbose()) {
+                utils::g_log << "Conjunctively partitioned TRs: " << num_partitioned << endl;
+            }
+        }
+
         min_transition_cost = transitions.begin()->first;
         if (min_transition_cost == 0) {
             hasTR0 = true;
@@ -64,6 +82,8 @@ void SymStateSpaceManager::shrinkBucket(Bucket &bucket, int maxNodes) {
     SymParamsMgr::SymParamsMgr(const plugins::Options &opts) :
             max_tr_time(opts.get<double>("max_tr_time")),
             max_tr_size(opts.get<int>("max_tr_size")),
+            tr_type(opts.get<TransitionRelationType>("tr_type")),
+            max_partition_size(opts.get<int>("max_partition_size")),
             max_aux_time(opts.get<double>("max_aux_time")),
             max_aux_nodes(opts.get<int>("max_aux_nodes")) {
         //Don't use edeletion with conditional effects
@@ -90,7 +110,9 @@ SymParamsMgr::SymParamsMgr() :
 
     void SymParamsMgr::print_options() const {
         if (utils::g_log.is_at_least_verbose()) {
-            utils::g_log << "TR(time=" << max_tr_time << ", nodes=" << max_tr_size << ")" << endl;
+            utils::g_log << "TR(time=" << max_tr_time << ", nodes=" << max_tr_size << ", type="
+                         << (tr_type == TransitionRelationType::CONJUNCTIVE ? "conjunctive" : "monolithic")
+                         << ", partition nodes=" << max_partition_size << ")" << endl;
             utils::g_log << "Aux(time=" << max_aux_time << ", nodes=" << max_aux_nodes << ")" << endl;
         }
     }
@@ -98,6 +120,10 @@ SymParamsMgr::SymParamsMgr() :
     void SymParamsMgr::add_options_to_feature(plugins::Feature &feature) {
         feature.add_option<int>("max_tr_size", "maximum size of TR BDDs", "100000");
         feature.add_option<double>("max_tr_time", "maximum time (ms) to generate TR BDDs", "60000");
+        feature.add_option<TransitionRelationType>("tr_type", "representation of the TRs that are not merged", "monolithic");
+        feature.add_option<int>("max_partition_size",
+                                "maximum size of each cluster of conjuncts in conjunctively partitioned TRs", "10000",
+                                plugins::Bounds("1", "infinity"));
         feature.add_option<int>("max_aux_nodes", "maximum size in pop operations", "1000000");
         feature.add_option<double>("max_aux_time", "maximum time (ms) in pop operations", "2000");
 
@@ -114,6 +140,12 @@ SymParamsMgr::SymParamsMgr() :
 
     }
 
+    static plugins::TypedEnumPlugin<TransitionRelationType> _enum_plugin({
+        {"monolithic", "one BDD per TR"},
+        {"conjunctive", "TRs of a single operator are kept as a list of clusters of conjuncts, quantifying each "
+                        "variable right after the last cluster that depends on it"}
+    });
+
     std::ostream &operator<<(std::ostream &os, const SymStateSpaceManager &abs) {
         abs.print(os, false);
         return os;
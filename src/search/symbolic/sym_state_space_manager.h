@@ -24,6 +24,10 @@ namespace symbolic {
 
     class TransitionRelation;
 
+    enum class TransitionRelationType {
+        MONOLITHIC, CONJUNCTIVE
+    };
+
 /*
  * All the methods may throw exceptions in case the time or nodes are exceeded.
  *
@@ -33,6 +37,8 @@ namespace symbolic {
         //Parameters to generate the TRs
         utils::Duration max_tr_time;
         long max_tr_size;
+        TransitionRelationType tr_type;
+        long max_partition_size;
 
         //Time and memory bounds for auxiliary operations
         utils::Duration max_aux_time;
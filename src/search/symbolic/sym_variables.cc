@@ -31,6 +31,19 @@ namespace symbolic {
         constructor();
     }
 
+    SymVariables::SymVariables(shared_ptr <BDDManager> manager,
+                               const VariableOrderingStrategy &variable_ordering,
+                               shared_ptr <AbstractTask> task,
+                               const vector<vector<int>> &partitions) :
+            bdd_manager(std::move(manager)), var_order (variable_ordering.compute_variable_ordering(*task, partitions)) {
+
+        variable_domain_sizes.reserve(var_order.size());
+        for (size_t i = 0; i < var_order.size(); i++) {
+            variable_domain_sizes.push_back(task->get_variable_domain_size(i));
+        }
+        constructor();
+    }
+
 
     void SymVariables::constructor() {
         size_t num_fd_vars = var_order.size();
@@ -62,6 +75,16 @@ namespace symbolic {
         for (int i = 0; i < numBDDVars; i++) {
             variables.push_back(bdd_manager->bddVar(i));
         }
+        //If the variables are reordered, the binary variables of each variable are kept together, and each one
+        //next to its primed copy, so that biimplications and swaps remain small
+        for (int var: var_order) {
+            if (!bdd_index_pre[var].empty()) {
+                bdd_manager->group_variables(bdd_index_pre[var][0], 2 * bdd_index_pre[var].size(), false);
+                for (int bdd_var: bdd_index_pre[var]) {
+                    bdd_manager->group_variables(bdd_var, 2, true);
+                }
+            }
+        }
 
         //DEBUG_MSG(cout << "Generating predicate BDDs: " << num_fd_vars << endl;);
         preconditionBDDs.resize(num_fd_vars);
@@ -33,7 +33,8 @@ namespace symbolic {
 /*
  * BDD-Variables for a symbolic exploration.
  * This information is global for every class using symbolic search.
- * The only decision fixed here is the variable ordering, which is assumed to be always fixed.
+ * The only decision fixed here is the initial variable ordering. The BDD manager may reorder the variables
+ * later, but the indices of the binary variables (bdd_index_pre, bdd_index_eff) never change.
  */
     class SymVariables {
         // Var order used by the algorithm.
@@ -68,6 +69,9 @@ namespace symbolic {
         SymVariables(std::shared_ptr<BDDManager> manager, std::vector<int> var_order, std::vector<int> variable_domain_sizes);
         SymVariables(std::shared_ptr<BDDManager> manager, const variable_ordering::VariableOrderingStrategy &variable_ordering,
                      std::shared_ptr<AbstractTask> task);
+        // The variables of each partition are kept contiguous in the variable order
+        SymVariables(std::shared_ptr<BDDManager> manager, const variable_ordering::VariableOrderingStrategy &variable_ordering,
+                     std::shared_ptr<AbstractTask> task, const std::vector<std::vector<int>> &partitions);
 
         size_t get_num_variables () const {
             return preconditionBDDs.size();
@@ -188,8 +192,9 @@ namespace symbolic {
                 //preconditionBDDs[v] [state[v]].PrintMinterm();
 
                 for (size_t j = 0; j < bdd_index_pre[v].size(); j++) {
-                    binState[pos++] = ((state[v] >> j) % 2);
-                    binState[pos++] = 0; //Skip interleaving variable
+                    binState[bdd_index_pre[v][j]] = ((state[v] >> j) % 2);
+                    binState[bdd_index_eff[v][j]] = 0;
+                    pos += 2;
                 }
             }
             /*std::cout << "Binary description: ";
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <limits>
 #include <ranges>
 
 #include "../task_proxy.h"
@@ -16,6 +17,7 @@ namespace symbolic {
 
         for (const auto &pre: op.get_preconditions()) {
             tBDD *= sV->preBDD(pre.get_variable().get_id(), pre.get_value());
+            conjuncts.push_back(sV->preBDD(pre.get_variable().get_id(), pre.get_value()));
         }
 
         map<int, BDD> effect_conditions;
@@ -54,6 +56,7 @@ namespace symbolic {
                 effectBDD += (effect_conditions[var] * sV->biimp(var));
             }
             tBDD *= effectBDD;
+            conjuncts.push_back(effectBDD);
         }
         if (tBDD.IsZero()) {
             cerr << "Warning: an operator has been disambiguated away when constructing the transition relation: "
@@ -83,6 +86,9 @@ namespace symbolic {
         if (!swapVarsA.empty()) {
             aux = from.SwapVariables(swapVarsA, swapVarsAp);
         }
+        if (isPartitioned()) {
+            return partitionedImage(aux, clusterExistsVars, 0).SwapVariables(swapVarsS, swapVarsSp);
+        }
         BDD tmp = tBDD.AndAbstract(aux, existsVars);
         BDD res = tmp.SwapVariables(swapVarsS, swapVarsSp);
 
@@ -95,6 +101,9 @@ namespace symbolic {
         if (!swapVarsA.empty()) {
             aux = from.SwapVariables(swapVarsA, swapVarsAp);
         }
+        if (isPartitioned()) {
+            return partitionedImage(aux, clusterExistsVars, maxNodes).SwapVariables(swapVarsS, swapVarsSp);
+        }
         //utils::Timer t;
         BDD tmp = tBDD.AndAbstract(aux, existsVars, maxNodes);
         //DEBUG_MSG(cout << " tmp " << tmp.nodeCount() << " in " << t(););
@@ -106,7 +115,7 @@ namespace symbolic {
 
     BDD TransitionRelation::preimage(const BDD &from) const {
         BDD tmp = from.SwapVariables(swapVarsS, swapVarsSp);
-        BDD res = tBDD.AndAbstract(tmp, existsBwVars);
+        BDD res = isPartitioned() ? partitionedImage(tmp, clusterExistsBwVars, 0) : tBDD.AndAbstract(tmp, existsBwVars);
         if (!swapVarsA.empty()) {
             res = res.SwapVariables(swapVarsA, swapVarsAp);
         }
@@ -118,7 +127,8 @@ namespace symbolic {
         //DEBUG_MSG(cout << "Image cost " << cost << " from " << from.nodeCount() << " with " << tBDD.nodeCount() << flush;);
         BDD tmp = from.SwapVariables(swapVarsS, swapVarsSp);
         //DEBUG_MSG(cout << " tmp " << tmp.nodeCount() << " in " << t() << flush;);
-        BDD res = tBDD.AndAbstract(tmp, existsBwVars, maxNodes);
+        BDD res = isPartitioned() ? partitionedImage(tmp, clusterExistsBwVars, maxNodes)
+                                  : tBDD.AndAbstract(tmp, existsBwVars, maxNodes);
         if (!swapVarsA.empty()) {
             res = res.SwapVariables(swapVarsA, swapVarsAp);
         }
@@ -127,6 +137,81 @@ namespace symbolic {
         return res;
     }
 
+    BDD TransitionRelation::partitionedImage(BDD from, const vector<BDD> &cubes, long maxNodes) const {
+        assert(cubes.size() == clusters.size());
+        for (size_t i = 0; i < clusters.size(); ++i) {
+            from = from.AndAbstract(clusters[i], cubes[i], maxNodes);
+        }
+        return from;
+    }
+
+    bool TransitionRelation::partition(long maxClusterNodes) {
+        if (conjuncts.size() <= 1) {
+            return false;
+        }
+
+        // Conjuncts are sorted by the level of their topmost variable in the current variable ordering
+        const Cudd &manager = *sV->get_bdd_manager()->mgr();
+        vector<pair<int, BDD>> sorted_conjuncts;
+        for (const BDD &conjunct: conjuncts) {
+            int top_level = numeric_limits<int>::max();
+            for (unsigned int index: conjunct.SupportIndices()) {
+                top_level = min(top_level, manager.ReadPerm(index));
+            }
+            sorted_conjuncts.emplace_back(top_level, conjunct);
+        }
+        stable_sort(sorted_conjuncts.begin(), sorted_conjuncts.end(),
+                    [](const auto &a, const auto &b) { return a.first < b.first; });
+
+        clusters.clear();
+        for (const auto &[top, conjunct]: sorted_conjuncts) {
+            if (!clusters.empty()) {
+                BDD merged = clusters.back() * conjunct;
+                if (merged.nodeCount() <= maxClusterNodes) {
+                    clusters.back() = merged;
+                    continue;
+                }
+            }
+            clusters.push_back(conjunct);
+        }
+
+        // Each variable is quantified after the last cluster that depends on it
+        vector<int> last_cluster;
+        for (size_t i = 0; i < clusters.size(); ++i) {
+            for (unsigned int index: clusters[i].SupportIndices()) {
+                if (index >= last_cluster.size()) {
+                    last_cluster.resize(index + 1, 0);
+                }
+                last_cluster[index] = i;
+            }
+        }
+        auto schedule = [&](const vector<BDD> &quantified_vars, vector<BDD> &cubes) {
+            cubes.assign(clusters.size(), sV->oneBDD());
+            for (const BDD &var: quantified_vars) {
+                unsigned int index = var.NodeReadIndex();
+                cubes[index < last_cluster.size() ? last_cluster[index] : 0] *= var;
+            }
+        };
+        schedule(swapVarsS, clusterExistsVars);
+        schedule(swapVarsSp, clusterExistsBwVars);
+        return true;
+    }
+
+    TransitionRelation TransitionRelation::transfer(Cudd &manager) const {
+        TransitionRelation result(*this);
+        result.tBDD = tBDD.Transfer(manager);
+        result.existsVars = existsVars.Transfer(manager);
+        result.existsBwVars = existsBwVars.Transfer(manager);
+        for (auto *swap_vars : {&result.swapVarsS, &result.swapVarsSp, &result.swapVarsA, &result.swapVarsAp,
+                                &result.conjuncts, &result.clusters, &result.clusterExistsVars,
+                                &result.clusterExistsBwVars}) {
+            for (BDD &var : *swap_vars) {
+                var = var.Transfer(manager);
+            }
+        }
+        return result;
+    }
+
     void TransitionRelation::merge(const TransitionRelation &t2, long maxNodes) {
         assert(cost == t2.cost);
         if (cost != t2.cost) {
@@ -181,6 +266,12 @@ namespace symbolic {
         }
 
         ops.insert(t2.ops.begin(), t2.ops.end());
+
+        // The disjunction of two TRs cannot be conjunctively partitioned
+        conjuncts.clear();
+        clusters.clear();
+        clusterExistsVars.clear();
+        clusterExistsBwVars.clear();
     }
 
     ostream &operator<<(std::ostream &os, const TransitionRelation &tr) {
@@ -189,7 +280,11 @@ namespace symbolic {
         os << op << ", ";
     }
 */
-        return os << "TR(" << tr.ops.size() << " ops, " << tr.tBDD.nodeCount() << " nodes)";
+        os << "TR(" << tr.ops.size() << " ops, " << tr.tBDD.nodeCount() << " nodes";
+        if (tr.isPartitioned()) {
+            os << ", " << tr.clusters.size() << " clusters";
+        }
+        return os << ")";
     }
 
 
@@ -30,6 +30,16 @@ namespace symbolic {
 
         std::set<OperatorID> ops; //List of operators represented by the TR
 
+        // Conjunctive partition of tBDD: preconditions and effects of each variable. Only available for TRs of
+        // a single operator, merging two TRs discards it.
+        std::vector<BDD> conjuncts;
+        // If not empty, images are computed by conjoining the clusters in order, quantifying after each cluster
+        // the variables that do not appear in the following ones (early quantification)
+        std::vector<BDD> clusters;
+        std::vector<BDD> clusterExistsVars, clusterExistsBwVars;
+
+        BDD partitionedImage(BDD from, const std::vector<BDD> &cubes, long maxNodes) const;
+
     public:
         //Constructor for transitions irrelevant for the abstraction
         TransitionRelation(SymVariables *sVars, const OperatorProxy &op, int cost_);
@@ -60,6 +70,17 @@ namespace symbolic {
 
         void merge(const TransitionRelation &t2, long maxNodes);
 
+        // Groups the conjuncts into clusters of at most maxClusterNodes nodes following the variable ordering and
+        // computes the quantification schedule. Returns false if the TR cannot be partitioned.
+        bool partition(long maxClusterNodes);
+
+        inline bool isPartitioned() const {
+            return !clusters.empty();
+        }
+
+        // Copy of the transition relation whose BDDs belong to another manager
+        TransitionRelation transfer(Cudd &manager) const;
+
         inline int getCost() const {
             return cost;
         }
@@ -43,6 +43,10 @@ namespace symbolic {
         }
         closed->init(init_bdd, open_list.get_min_new_g());
 
+        if (params.image_threads > 1) {
+            parallel_image = make_unique<ParallelImage>(params.image_threads, *mgr->getVars()->get_bdd_manager()->mgr());
+        }
+
         //TODO: Check against goal to detect cases where the initial state is a goal state
 
         solution->setLowerBound(getF(), p.log);
@@ -60,54 +64,72 @@ namespace symbolic {
 
     bool UniformCostSearch::stepImage(utils::Duration maxTime, long maxNodes) {
         Timer sTime;
-        StepImage step_image = open_list.pop();
+        vector<StepImage> steps;
+        if (parallel_image) {
+            steps = open_list.pop_steps(parallel_image->get_num_workers());
+        } else {
+            steps.push_back(open_list.pop());
+        }
 
-        if (p.log.is_at_least_debug()) {
-            p.log << ">> Step: " << *mgr << (fw ? " fw" : " bw") << ", " << step_image << " num states: " << mgr->
-                    getVars()->numStates(step_image.bdd) << " total nodes: " << mgr->totalNodes() << endl;
-        } else if (p.log.is_at_least_verbose()) {
-            p.log << ">> Step: " << *mgr << (fw ? " fw" : " bw") << ", " << step_image << endl;
+        for (const StepImage &step_image : steps) {
+            if (p.log.is_at_least_debug()) {
+                p.log << ">> Step: " << *mgr << (fw ? " fw" : " bw") << ", " << step_image << " num states: " << mgr->
+                        getVars()->numStates(step_image.bdd) << " total nodes: " << mgr->totalNodes() << endl;
+            } else if (p.log.is_at_least_verbose()) {
+                p.log << ">> Step: " << *mgr << (fw ? " fw" : " bw") << ", " << step_image << endl;
+            }
         }
 
-        auto maybe_generated_states = mgr->getVars()->get_bdd_manager()->compute_bdd_with_time_limit(maxTime, [&]() {
-            return step_image.transition_relation->image(fw, step_image.bdd, maxNodes);
-        });
+        vector<optional<BDD>> maybe_generated_states;
+        if (steps.size() > 1) {
+            vector<BDD> states;
+            vector<const TransitionRelation *> transition_relations;
+            for (const StepImage &step_image : steps) {
+                states.push_back(step_image.bdd);
+                transition_relations.push_back(step_image.transition_relation);
+            }
+            maybe_generated_states = parallel_image->image(fw, states, transition_relations,
+                                                           *mgr->getVars()->get_bdd_manager()->mgr(), maxTime, maxNodes);
+        } else {
+            maybe_generated_states.push_back(mgr->getVars()->get_bdd_manager()->compute_bdd_with_time_limit(maxTime, [&]() {
+                return steps[0].transition_relation->image(fw, steps[0].bdd, maxNodes);
+            }));
+        }
 
-        if (!maybe_generated_states.has_value()) {
-            p.log << "Step failed" << endl;
-            //TODO: estimation.violated()
-            open_list.insert(step_image);
+        bool any_succeeded = false;
+        for (size_t i = 0; i < steps.size(); ++i) {
+            if (!maybe_generated_states[i].has_value()) {
+                p.log << "Step failed" << endl;
+                //TODO: estimation.violated()
+                open_list.insert(steps[i]);
+            } else {
+                any_succeeded = true;
+            }
+        }
+        if (!any_succeeded) {
             stats.add_image_time_failed(sTime());
             return false;
         }
 
-        BDD generated_states = maybe_generated_states.value();
         auto time_image = sTime();
         stats.add_image_time(time_image);
-        estimation.stepTaken(time_image, step_image.bdd.nodeCount());
-        if (p.log.is_at_least_debug()) {
-            p.log << "Generated states: " << generated_states.nodeCount() << " num states: " << mgr->getVars()->
-                    numStates(generated_states) << " time image: " << time_image << endl;
+        long step_nodes = 0;
+        for (const StepImage &step_image : steps) {
+            step_nodes += step_image.bdd.nodeCount();
         }
+        estimation.stepTaken(time_image, step_nodes);
 
-        if (!generated_states.IsZero()) {
-            //Check the cut (removing states classified, since they do not need to be included in open)
-            auto sol = perfectHeuristic->checkCut(closed, generated_states, step_image.new_g(), fw);
-            if (sol) {
-                // Solution found :)
-                solution->new_solution(*sol, p.log);
+        for (size_t i = 0; i < steps.size(); ++i) {
+            if (!maybe_generated_states[i].has_value()) {
+                continue;
             }
-
-            //TODO: We should reconsider whether the commented out operation makes sense. I don't think so because
-            //      if we already found a solution we should not be expanding those states,
-            //      and duplicate detection should be performed somewhere else.
-            //generated_states *= perfectHeuristic->notClosed();   //Prune everything closed in opposite direction
-
-            closed->put_in_frontier(step_image.new_g(), generated_states);
-
-            if (solution->solved()) {
+            const BDD &generated_states = maybe_generated_states[i].value();
+            if (p.log.is_at_least_debug()) {
+                p.log << "Generated states: " << generated_states.nodeCount() << " num states: " << mgr->getVars()->
+                        numStates(generated_states) << " time image: " << time_image << endl;
+            }
+            if (insert_generated_states(steps[i], generated_states)) {
                 //TODO: Here we are not closing the states, which may be a problem for heuristic generation from the closed list
-                //            DEBUG_MSG(p.log << "SOLVED!!!: " << engine->getLowerBound() << " >= " << engine->getUpperBound() << endl;);
                 return true; //If it has been solved, return
             }
         }
@@ -127,6 +149,29 @@ namespace symbolic {
         return true;
     }
 
+    bool UniformCostSearch::insert_generated_states(const StepImage &step_image, const BDD &generated_states) {
+        if (generated_states.IsZero()) {
+            return false;
+        }
+
+        //Check the cut (removing states classified, since they do not need to be included in open)
+        auto sol = perfectHeuristic->checkCut(closed, generated_states, step_image.new_g(), fw);
+        if (sol) {
+            // Solution found :)
+            solution->new_solution(*sol, p.log);
+        }
+
+        //TODO: We should reconsider whether the commented out operation makes sense. I don't think so because
+        //      if we already found a solution we should not be expanding those states,
+        //      and duplicate detection should be performed somewhere else.
+        //generated_states *= perfectHeuristic->notClosed();   //Prune everything closed in opposite direction
+
+        closed->put_in_frontier(step_image.new_g(), generated_states);
+
+        //            DEBUG_MSG(p.log << "SOLVED!!!: " << engine->getLowerBound() << " >= " << engine->getUpperBound() << endl;);
+        return solution->solved();
+    }
+
     bool UniformCostSearch::isSearchableWithNodes(int maxNodes) const {
         return nextStepNodes() <= maxNodes;
     }
@@ -224,6 +269,21 @@ namespace symbolic {
         return next;
     }
 
+    vector<StepImage> OpenList::pop_steps(int max_steps) {
+        assert(!open.empty());
+        assert(!open.begin()->second.empty());
+        auto &tasks = open.begin()->second;
+        vector<StepImage> steps;
+        while (!tasks.empty() && static_cast<int>(steps.size()) < max_steps) {
+            steps.push_back(tasks.back());
+            tasks.pop_back();
+        }
+        if (tasks.empty()) {
+            open.erase(open.begin());
+        }
+        return steps;
+    }
+
     const StepImage & OpenList::nextStep() const {
         assert(!open.empty());
         assert(!open.begin()->second.empty());
@@ -3,6 +3,7 @@
 
 #include "sym_state_space_manager.h"
 #include "closed_list.h"
+#include "parallel_image.h"
 
 #include "../algorithms/step_time_estimation.h"
 #include "../algorithms/priority_queues.h"
@@ -59,6 +60,8 @@ namespace symbolic {
         bool empty() const;
 
         StepImage pop();
+        // Pops up to max_steps steps, all with the minimum new g value
+        std::vector<StepImage> pop_steps(int max_steps);
 
         int get_min_new_g() const;
         int get_min_old_g() const;
@@ -110,6 +113,12 @@ namespace symbolic {
         StepCostEstimation estimation;
         SymExpStatistics stats;
 
+        // Only used if images are computed concurrently (image_threads > 1)
+        std::unique_ptr<ParallelImage> parallel_image;
+
+        // Adds the states generated by a step to the frontier. Returns true if the problem has been solved
+        bool insert_generated_states(const StepImage &step_image, const BDD &generated_states);
+
         // Returns the subset with h_value h
         BDD compute_heuristic(const BDD &from, int fVal, int hVal, bool store_eval);
 
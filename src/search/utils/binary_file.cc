@@ -0,0 +1,129 @@
+#include "binary_file.h"
+
+#include "system.h"
+
+#include <cstdio>
+#include <fstream>
+
+#if OPERATING_SYSTEM != WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace utils {
+static const uint64_t MAGIC_NUMBER = 0x4e49424e414e4f43; // "CONANBIN"
+
+BinaryWriter::BinaryWriter(uint32_t version, uint64_t key) {
+    write(MAGIC_NUMBER);
+    write(version);
+    write(key);
+}
+
+void BinaryWriter::write_vector(const vector<bool> &values) {
+    vector<uint8_t> bytes(values.begin(), values.end());
+    write_vector(bytes);
+}
+
+void BinaryWriter::write_string(const string &value) {
+    write<uint64_t>(value.size());
+    append(value.data(), value.size());
+}
+
+bool BinaryWriter::save(const string &path) const {
+    const string tmp_path = path + ".tmp" + to_string(get_process_id());
+    {
+        ofstream file(tmp_path, ios::binary | ios::trunc);
+        if (!file.write(buffer.data(), buffer.size())) {
+            remove(tmp_path.c_str());
+            return false;
+        }
+    }
+    if (rename(tmp_path.c_str(), path.c_str()) != 0) {
+        remove(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+BinaryReader::BinaryReader(const char *data, size_t size)
+    : data(data), size(size), position(0) {
+}
+
+const char *BinaryReader::consume(size_t num_bytes) {
+    if (num_bytes > size - position) {
+        throw BinaryFileError("unexpected end of file");
+    }
+    const char *result = data + position;
+    position += num_bytes;
+    return result;
+}
+
+void BinaryReader::check_header(uint32_t version, uint64_t key) {
+    if (read<uint64_t>() != MAGIC_NUMBER) {
+        throw BinaryFileError("not a binary cache file");
+    }
+    if (read<uint32_t>() != version) {
+        throw BinaryFileError("different format version");
+    }
+    if (read<uint64_t>() != key) {
+        throw BinaryFileError("different key");
+    }
+}
+
+vector<bool> BinaryReader::read_bool_vector() {
+    vector<uint8_t> bytes = read_vector<uint8_t>();
+    return vector<bool>(bytes.begin(), bytes.end());
+}
+
+string BinaryReader::read_string() {
+    uint64_t length = read<uint64_t>();
+    const char *chars = consume(length);
+    return string(chars, length);
+}
+
+#if OPERATING_SYSTEM != WINDOWS
+MappedFile::MappedFile(const string &path)
+    : data(nullptr), size(0) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+        void *address = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            data = static_cast<const char *>(address);
+            size = file_stat.st_size;
+        }
+    }
+    // The mapping remains valid after closing the file descriptor
+    close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (data) {
+        munmap(const_cast<char *>(data), size);
+    }
+}
+#else
+MappedFile::MappedFile(const string &path)
+    : data(nullptr), size(0) {
+    ifstream file(path, ios::binary);
+    if (!file) {
+        return;
+    }
+    buffer.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    if (!buffer.empty()) {
+        data = buffer.data();
+        size = buffer.size();
+    }
+}
+
+MappedFile::~MappedFile() {
+}
+#endif
+}
@@ -0,0 +1,129 @@
+#ifndef UTILS_BINARY_FILE_H
+#define UTILS_BINARY_FILE_H
+
+#include "exceptions.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace utils {
+/*
+  Binary serialization of trivially copyable values and vectors of them, used
+  to store precomputed data on disk. Values are stored in the native byte
+  order, so files are not meant to be shared between different platforms.
+
+  Every file starts with a header with a magic number, a format version and a
+  key identifying its content. Readers must check the header and discard the
+  file if any of them does not match.
+*/
+class BinaryFileError : public Exception {
+public:
+    explicit BinaryFileError(const std::string &msg) : Exception(msg) {
+    }
+};
+
+class BinaryWriter {
+    std::vector<char> buffer;
+
+    void append(const void *data, size_t num_bytes) {
+        const char *bytes = static_cast<const char *>(data);
+        buffer.insert(buffer.end(), bytes, bytes + num_bytes);
+    }
+public:
+    BinaryWriter(std::uint32_t version, std::uint64_t key);
+
+    template<typename T>
+    void write(const T &value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        append(&value, sizeof(T));
+    }
+
+    template<typename T>
+    void write_vector(const std::vector<T> &values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        write<std::uint64_t>(values.size());
+        append(values.data(), values.size() * sizeof(T));
+    }
+
+    void write_vector(const std::vector<bool> &values);
+
+    void write_string(const std::string &value);
+
+    /*
+      Writes the content to a temporary file that is then renamed to path, so
+      that other processes never read a partially written file. Returns false
+      if the file could not be written.
+    */
+    bool save(const std::string &path) const;
+};
+
+class BinaryReader {
+    const char *data;
+    size_t size;
+    size_t position;
+
+    const char *consume(size_t num_bytes);
+public:
+    BinaryReader(const char *data, size_t size);
+
+    // Throws BinaryFileError if the header does not match
+    void check_header(std::uint32_t version, std::uint64_t key);
+
+    template<typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value;
+        std::memcpy(&value, consume(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    template<typename T>
+    std::vector<T> read_vector() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        std::uint64_t num_values = read<std::uint64_t>();
+        if (num_values > (size - position) / sizeof(T)) {
+            throw BinaryFileError("vector exceeds the end of the file");
+        }
+        std::vector<T> values(num_values);
+        std::memcpy(values.data(), consume(num_values * sizeof(T)), num_values * sizeof(T));
+        return values;
+    }
+
+    std::vector<bool> read_bool_vector();
+
+    std::string read_string();
+
+    bool at_end() const {
+        return position == size;
+    }
+};
+
+/*
+  Read-only view of a whole file. On Unix, the file is mapped into memory, so
+  only the pages that are actually read are loaded.
+*/
+class MappedFile {
+    const char *data;
+    size_t size;
+    // Used instead of a memory mapping on Windows
+    std::vector<char> buffer;
+public:
+    explicit MappedFile(const std::string &path);
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    ~MappedFile();
+
+    bool is_open() const {
+        return data != nullptr;
+    }
+
+    BinaryReader get_reader() const {
+        return BinaryReader(data, size);
+    }
+};
+}
+
+#endif
@@ -0,0 +1,161 @@
+#include "thread_pool.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace utils {
+ThreadPool::ThreadPool(int num_threads)
+    : current_loop_body(nullptr),
+      generation(0),
+      num_busy_threads(0),
+      stopping(false) {
+    assert(num_threads >= 1);
+    ranges.reserve(num_threads);
+    for (int worker = 0; worker < num_threads; ++worker) {
+        ranges.push_back(make_unique<IterationRange>());
+    }
+    threads.reserve(num_threads - 1);
+    for (int worker = 1; worker < num_threads; ++worker) {
+        threads.emplace_back(&ThreadPool::worker_loop, this, worker);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_available.notify_all();
+    for (thread &t : threads) {
+        t.join();
+    }
+}
+
+bool ThreadPool::pop_iteration(int worker, int &index) {
+    IterationRange &range = *ranges[worker];
+    lock_guard<std::mutex> lock(range.mutex);
+    if (range.begin == range.end) {
+        return false;
+    }
+    index = range.begin++;
+    return true;
+}
+
+bool ThreadPool::steal_iterations(int worker) {
+    int num_workers = ranges.size();
+    for (int offset = 1; offset < num_workers; ++offset) {
+        IterationRange &victim = *ranges[(worker + offset) % num_workers];
+        int stolen_begin, stolen_end;
+        {
+            lock_guard<std::mutex> lock(victim.mutex);
+            int remaining = victim.end - victim.begin;
+            if (remaining == 0) {
+                continue;
+            }
+            stolen_end = victim.end;
+            stolen_begin = victim.end - (remaining + 1) / 2;
+            victim.end = stolen_begin;
+        }
+        /*
+          Our own range is empty, so other workers cannot take anything from
+          it until we publish the stolen iterations.
+        */
+        IterationRange &own = *ranges[worker];
+        lock_guard<std::mutex> lock(own.mutex);
+        own.begin = stolen_begin;
+        own.end = stolen_end;
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::run_iterations(int worker, const function<void(int)> &body) {
+    while (true) {
+        int index;
+        if (!pop_iteration(worker, index)) {
+            if (steal_iterations(worker)) {
+                continue;
+            }
+            break;
+        }
+        try {
+            body(index);
+        } catch (...) {
+            lock_guard<std::mutex> lock(mutex);
+            if (!first_exception) {
+                first_exception = current_exception();
+            }
+        }
+    }
+}
+
+void ThreadPool::worker_loop(int worker) {
+    int last_generation = 0;
+    while (true) {
+        const function<void(int)> *body;
+        {
+            unique_lock<std::mutex> lock(mutex);
+            work_available.wait(lock, [&]() {
+                                    return stopping || generation != last_generation;
+                                });
+            if (stopping) {
+                return;
+            }
+            last_generation = generation;
+            body = current_loop_body;
+        }
+        run_iterations(worker, *body);
+        {
+            lock_guard<std::mutex> lock(mutex);
+            if (--num_busy_threads == 0) {
+                work_finished.notify_one();
+            }
+        }
+    }
+}
+
+void ThreadPool::parallel_for(int num_iterations, const function<void(int)> &body) {
+    if (num_iterations <= 0) {
+        return;
+    }
+    int num_workers = ranges.size();
+    if (num_workers == 1) {
+        for (int i = 0; i < num_iterations; ++i) {
+            body(i);
+        }
+        return;
+    }
+
+    for (int worker = 0; worker < num_workers; ++worker) {
+        IterationRange &range = *ranges[worker];
+        lock_guard<std::mutex> lock(range.mutex);
+        range.begin = static_cast<int>(static_cast<long long>(num_iterations) * worker / num_workers);
+        range.end = static_cast<int>(static_cast<long long>(num_iterations) * (worker + 1) / num_workers);
+    }
+    {
+        lock_guard<std::mutex> lock(mutex);
+        current_loop_body = &body;
+        first_exception = nullptr;
+        num_busy_threads = num_workers - 1;
+        ++generation;
+    }
+    work_available.notify_all();
+
+    run_iterations(0, body);
+
+    exception_ptr exception;
+    {
+        unique_lock<std::mutex> lock(mutex);
+        work_finished.wait(lock, [&]() {
+                               return num_busy_threads == 0;
+                           });
+        current_loop_body = nullptr;
+        exception = first_exception;
+        first_exception = nullptr;
+    }
+    if (exception) {
+        rethrow_exception(exception);
+    }
+}
+}
@@ -0,0 +1,68 @@
+#ifndef UTILS_THREAD_POOL_H
+#define UTILS_THREAD_POOL_H
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils {
+/*
+  Fixed-size pool of worker threads that runs parallel loops.
+
+  The iterations of a loop are initially split into one contiguous range per
+  worker. A worker that runs out of iterations steals the upper half of the
+  remaining range of another worker, so loops whose iterations have very
+  different costs (e.g., one iteration per factor of an FTS) are still spread
+  over all threads.
+
+  The calling thread participates as worker 0, so a pool with n threads only
+  spawns n - 1 additional threads. Loops must not be nested and parallel_for
+  must not be called concurrently from several threads.
+*/
+class ThreadPool {
+    struct IterationRange {
+        std::mutex mutex;
+        int begin = 0;
+        int end = 0;
+    };
+
+    std::vector<std::unique_ptr<IterationRange>> ranges;
+    std::vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::condition_variable work_available;
+    std::condition_variable work_finished;
+    const std::function<void(int)> *current_loop_body;
+    int generation;
+    int num_busy_threads;
+    bool stopping;
+    std::exception_ptr first_exception;
+
+    bool pop_iteration(int worker, int &index);
+    bool steal_iterations(int worker);
+    void run_iterations(int worker, const std::function<void(int)> &body);
+    void worker_loop(int worker);
+public:
+    explicit ThreadPool(int num_threads);
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+    ~ThreadPool();
+
+    int get_num_threads() const {
+        return ranges.size();
+    }
+
+    /*
+      Call body(i) for all i in [0, num_iterations) and return once all calls
+      have finished. If some call throws, the first exception is rethrown
+      after the remaining iterations completed.
+    */
+    void parallel_for(int num_iterations, const std::function<void(int)> &body);
+};
+}
+
+#endif
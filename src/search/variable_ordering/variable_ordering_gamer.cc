@@ -4,119 +4,170 @@
 #include "../task_utils/causal_graph.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
+#include "../utils/thread_pool.h"
 #include "../plugins/plugin.h"
 #include "../utils/logging.h"
 #include "../utils/markup.h"
 #include "../utils/rng_options.h"
 
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
 using namespace std;
 using plugins::Options;
 using causal_graph::CausalGraph;
 
 namespace variable_ordering {
-    GamerVariableOrdering::GamerVariableOrdering(int runs, int iterations_per_run, int random_seed) :
-            rng(utils::get_rng(random_seed)), runs(runs), iterations_per_run(iterations_per_run) {
+    GamerVariableOrdering::GamerVariableOrdering(int runs, int iterations_per_run, int num_threads, int random_seed) :
+            rng(utils::get_rng(random_seed)), runs(runs), iterations_per_run(iterations_per_run),
+            num_threads(num_threads) {
     }
 
     void GamerVariableOrdering::print_options() const {
-        cout << "Gamer variable ordering, runs " << runs << ", iterations per run: " << iterations_per_run << endl;
+        cout << "Gamer variable ordering, runs " << runs << ", iterations per run: " << iterations_per_run
+             << ", threads: " << num_threads << endl;
     }
-    //Returns a optimized variable ordering that reorders the variables
-    //according to the standard causal graph criterion
 
-    vector<int> GamerVariableOrdering::compute_variable_ordering(const AbstractTask &task) const {
+    static InfluenceGraph create_influence_graph(const AbstractTask &task) {
         TaskProxy task_proxy(task);
-
         const CausalGraph &cg = task_proxy.get_causal_graph();
 
-        vector<int> var_order;
-        if (var_order.empty()) {
-            for (int v = 0; v < task.get_num_variables(); v++) {
-                var_order.push_back(v);
-            }
-        }
-
-        InfluenceGraph ig_partitions(task.get_num_variables());
+        InfluenceGraph ig(task.get_num_variables());
         for (int v = 0; v < task.get_num_variables(); v++) {
             for (int v2: cg.get_successors(v)) {
                 if ((int) v != v2) {
-                    ig_partitions.set_influence(v, v2);
+                    ig.set_influence(v, v2);
                 }
             }
         }
+        return ig;
+    }
+
+    //Returns a optimized variable ordering that reorders the variables
+    //according to the standard causal graph criterion
+    vector<int> GamerVariableOrdering::compute_variable_ordering(const AbstractTask &task) const {
+        vector<int> var_order;
+        for (int v = 0; v < task.get_num_variables(); v++) {
+            var_order.push_back(v);
+        }
 
-        double value_optimization_function = optimize_variable_ordering_gamer(ig_partitions, iterations_per_run,
-                                                                              var_order);
+        InfluenceGraph ig = create_influence_graph(task);
+        return optimize_multi_start(ig, var_order, {0}, {task.get_num_variables()});
+    }
 
-        //DEBUG_MSG(cout << "Value: " << value_optimization_function << endl;);
+    vector<int> GamerVariableOrdering::compute_variable_ordering(const AbstractTask &task,
+                                                                 const vector<vector<int>> &partitions) const {
+        vector<int> var_order;
+        vector<int> partition_begin;
+        vector<int> partition_sizes;
+        for (const auto &partition: partitions) {
+            partition_begin.push_back(var_order.size());
+            partition_sizes.push_back(partition.size());
+            var_order.insert(var_order.end(), partition.begin(), partition.end());
+        }
+        assert(static_cast<int>(var_order.size()) == task.get_num_variables());
 
-        for (int counter = 0; counter < runs; counter++) {
-            vector<int> new_order = var_order;
-            rng->shuffle(new_order);
-            double new_value = optimize_variable_ordering_gamer(ig_partitions, iterations_per_run, var_order);
+        InfluenceGraph ig = create_influence_graph(task);
+        return optimize_multi_start(ig, var_order, partition_begin, partition_sizes);
+    }
 
-            if (new_value < value_optimization_function) {
-                value_optimization_function = new_value;
-                var_order.swap(new_order);
-                //DEBUG_MSG(cout << "New value: " << value_optimization_function << endl;);
-            }
+    vector<int> GamerVariableOrdering::optimize_multi_start(const InfluenceGraph &ig, const vector<int> &initial_order,
+                                                            const vector<int> &partition_begin,
+                                                            const vector<int> &partition_sizes) const {
+        // The seeds are drawn before starting, so the result does not depend on the number of threads
+        const int num_runs = runs + 1;
+        vector<int> seeds;
+        for (int run = 0; run < num_runs; ++run) {
+            seeds.push_back(rng->random(numeric_limits<int>::max()));
         }
 
-        // cout << "Var ordering: ";
-        // for(int v : var_order) cout << v << " ";
-        // cout  << endl;
-        return var_order;
+        vector<vector<int>> orders(num_runs, initial_order);
+        vector<double> values(num_runs);
+        utils::ThreadPool thread_pool(min(num_threads, num_runs));
+        thread_pool.parallel_for(num_runs, [&](int run) {
+            utils::RandomNumberGenerator run_rng(seeds[run]);
+            vector<int> &order = orders[run];
+            // The first run starts from the initial order, the others from a random shuffle of it
+            if (run > 0) {
+                for (size_t p = 0; p < partition_begin.size(); ++p) {
+                    for (int i = partition_sizes[p] - 1; i > 0; --i) {
+                        swap(order[partition_begin[p] + i], order[partition_begin[p] + run_rng.random(i + 1)]);
+                    }
+                }
+            }
+            values[run] = optimize_variable_ordering_gamer(ig, iterations_per_run, order, partition_begin,
+                                                           partition_sizes, run_rng);
+        });
+
+        // Ties are broken in favour of the earliest run
+        int best_run = ranges::min_element(values) - values.begin();
+        //DEBUG_MSG(cout << "Value: " << values[best_run] << endl;);
+        return orders[best_run];
     }
 
-    double InfluenceGraph::compute_function_incremental_swap(const vector<int> &order,
+    double InfluenceGraph::compute_function_incremental_swap(const vector<int> &order, const vector<int> &positions,
                                                              double totalDistance, int swapIndex1,
                                                              int swapIndex2) const {
-        //Compute the new value of the optimization function
-        for (int i = 0; i < int(order.size()); i++) {
-            if ((int) i == swapIndex1 || (int) i == swapIndex2)
+        //Compute the new value of the optimization function. The distance between the two swapped variables does
+        //not change, only the distances to the neighbours of each of them
+        const int v1 = order[swapIndex1];
+        const int v2 = order[swapIndex2];
+        double delta = 0;
+        for (int v: neighbors[v1]) {
+            if (v == v2)
                 continue;
-
-            if (influence(order[i], order[swapIndex1]))
-                totalDistance += (-(i - swapIndex1) * (i - swapIndex1)
-                                  + (i - swapIndex2) * (i - swapIndex2));
-
-            if (influence(order[i], order[swapIndex2]))
-                totalDistance += (-(i - swapIndex2) * (i - swapIndex2)
-                                  + (i - swapIndex1) * (i - swapIndex1));
+            const int i = positions[v];
+            delta += -(i - swapIndex1) * (i - swapIndex1) + (i - swapIndex2) * (i - swapIndex2);
+        }
+        for (int v: neighbors[v2]) {
+            if (v == v1)
+                continue;
+            const int i = positions[v];
+            delta += -(i - swapIndex2) * (i - swapIndex2) + (i - swapIndex1) * (i - swapIndex1);
         }
 
-        return totalDistance;
+        return totalDistance + delta;
     }
 
     double GamerVariableOrdering::optimize_variable_ordering_gamer(const InfluenceGraph &ig, int iterations,
-                                                                   vector<int> &order) const {
+                                                                   vector<int> &order,
+                                                                   const vector<int> &partition_begin,
+                                                                   const vector<int> &partition_sizes,
+                                                                   utils::RandomNumberGenerator &run_rng) {
         double totalDistance = ig.compute_function(order);
+        if (partition_begin.empty()) {
+            return totalDistance;
+        }
+
+        vector<int> positions(order.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            positions[order[i]] = i;
+        }
 
         double oldTotalDistance = totalDistance;
         //Repeat iterations times
         for (int counter = 0; counter < iterations; counter++) {
             //Swap variable
-            int swapIndex1 = rng->random(order.size());
-            int swapIndex2 = rng->random(order.size());
+            int partition = run_rng.random(partition_begin.size());
+            if (partition_sizes[partition] <= 1)
+                continue;
+            int swapIndex1 = partition_begin[partition] + run_rng.random(partition_sizes[partition]);
+            int swapIndex2 = partition_begin[partition] + run_rng.random(partition_sizes[partition]);
             if (swapIndex1 == swapIndex2)
                 continue;
 
-            totalDistance = ig.compute_function_incremental_swap(order, totalDistance, swapIndex1, swapIndex2);
-
+            totalDistance = ig.compute_function_incremental_swap(order, positions, totalDistance, swapIndex1,
+                                                                 swapIndex2);
 
             //Apply the swap if it is worthy
             if (totalDistance < oldTotalDistance) {
-                int tmp = order[swapIndex1];
-                order[swapIndex1] = order[swapIndex2];
-                order[swapIndex2] = tmp;
+                swap(order[swapIndex1], order[swapIndex2]);
+                positions[order[swapIndex1]] = swapIndex1;
+                positions[order[swapIndex2]] = swapIndex2;
                 oldTotalDistance = totalDistance;
 
-                /*if(totalDistance != compute_function(order)){
-                  cerr << "Error computing total distance: " << totalDistance << " " << compute_function(order) << endl;
-                  exit(-1);
-                }else{
-                  cout << "Bien: " << totalDistance << endl;
-                }*/
+                assert(totalDistance == ig.compute_function(order));
             } else {
                 totalDistance = oldTotalDistance;
             }
@@ -127,11 +178,16 @@ namespace variable_ordering {
 
 
     double InfluenceGraph::compute_function(const std::vector<int> &order) const {
+        vector<int> positions(num_variables);
+        for (size_t i = 0; i < order.size(); ++i) {
+            positions[order[i]] = i;
+        }
+
         double totalDistance = 0;
-        for (size_t i = 0; i < order.size() - 1; i++) {
-            for (size_t j = i + 1; j < order.size(); j++) {
-                if (influence(order[i], order[j])) {
-                    totalDistance += (j - i) * (j - i);
+        for (int v = 0; v < num_variables; ++v) {
+            for (int v2: neighbors[v]) {
+                if (positions[v2] > positions[v]) {
+                    totalDistance += (positions[v2] - positions[v]) * (positions[v2] - positions[v]);
                 }
             }
         }
@@ -139,66 +195,20 @@ namespace variable_ordering {
     }
 
 
-    InfluenceGraph::InfluenceGraph(int num) {
-        influence_graph.resize(num);
-        for (auto &i: influence_graph) {
-            i.resize(num, 0);
-        }
+    InfluenceGraph::InfluenceGraph(int num) : num_variables(num), words_per_row((num + BITS_PER_WORD - 1) / BITS_PER_WORD),
+                                              influence_bits(static_cast<size_t>(num) * words_per_row, 0),
+                                              neighbors(num) {
     }
 
-/*
-    void InfluenceGraph::optimize_variable_ordering_gamer(vector <int> &order,
-                                                          vector <int> &partition_begin,
-                                                          vector <int> &partition_sizes,
-                                                          int iterations) const {
-        double totalDistance = compute_function(order);
-
-        double oldTotalDistance = totalDistance;
-        //Repeat iterations times
-        for (int counter = 0; counter < iterations; counter++) {
-            //Swap variable
-            int partition = (*g_rng())(partition_begin.size());
-            if (partition_sizes[partition] <= 1)
-                continue;
-            int swapIndex1 = partition_begin[partition] + (*g_rng())(partition_sizes[partition]);
-            int swapIndex2 = partition_begin[partition] + (*g_rng())(partition_sizes[partition]);
-            if (swapIndex1 == swapIndex2)
-                continue;
-
-            //Compute the new value of the optimization function
-            for (int i = 0; i < int(order.size()); i++) {
-                if ((int)i == swapIndex1 || (int)i == swapIndex2)
-                    continue;
-
-                if (influence(order[i], order[swapIndex1]))
-                    totalDistance += (-(i - swapIndex1) * (i - swapIndex1)
-                                      + (i - swapIndex2) * (i - swapIndex2));
-
-                if (influence(order[i], order[swapIndex2]))
-                    totalDistance += (-(i - swapIndex2) * (i - swapIndex2)
-                                      + (i - swapIndex1) * (i - swapIndex1));
-            }
-
-            //Apply the swap if it is worthy
-            if (totalDistance < oldTotalDistance) {
-                int tmp = order[swapIndex1];
-                order[swapIndex1] = order[swapIndex2];
-                order[swapIndex2] = tmp;
-                oldTotalDistance = totalDistance;
-
-                if(totalDistance != compute_function(order)){
-                  cerr << "Error computing total distance: " << totalDistance << " " << compute_function(order) << endl;
-                  exit(-1);
-                }else{
-                  cout << "Bien: " << totalDistance << endl;
-                }
-            } else {
-                totalDistance = oldTotalDistance;
-            }
+    void InfluenceGraph::set_influence(int v1, int v2) {
+        if (influence(v1, v2)) {
+            return;
         }
-//  cout << "Total distance: " << totalDistance << endl;
+        influence_bits[static_cast<size_t>(v1) * words_per_row + v2 / BITS_PER_WORD] |= Word(1) << (v2 % BITS_PER_WORD);
+        influence_bits[static_cast<size_t>(v2) * words_per_row + v1 / BITS_PER_WORD] |= Word(1) << (v1 % BITS_PER_WORD);
+        neighbors[v1].push_back(v2);
+        neighbors[v2].push_back(v1);
     }
-*/
 
 
 
@@ -230,12 +240,20 @@ namespace variable_ordering {
                     "number of iterations the optimization takes per run",
                     "50000",
                     plugins::Bounds("1", "infinity"));
+
+            add_option<int>(
+                    "threads",
+                    "number of threads that perform the runs concurrently. Each run uses its own random number "
+                    "generator, seeded in advance, so the result does not depend on the number of threads",
+                    "1",
+                    plugins::Bounds("1", "infinity"));
         }
 
         virtual shared_ptr<GamerVariableOrdering> create_component(const plugins::Options &opts) const override {
             return plugins::make_shared_from_arg_tuples<GamerVariableOrdering>(
                     opts.get<int>("runs"),
                     opts.get<int>("iterations_per_run"),
+                    opts.get<int>("threads"),
                     utils::get_rng_arguments_from_options(opts));
         }
 
@@ -2,6 +2,7 @@
 #define VARIABLE_ORDERING_VARIABLE_ORDERING_GAMER_H
 
 #include "variable_ordering_strategy.h"
+#include <cstdint>
 #include <vector>
 #include <memory>
 
@@ -14,23 +15,37 @@ namespace utils {
 }
 namespace variable_ordering {
 
+    /*
+     * Undirected graph over the variables, stored both as adjacency lists and as a bitset matrix. The value of an
+     * order is the sum of the squared distances between influencing variables. The incremental evaluation of a
+     * swap only visits the neighbours of the two swapped variables.
+     */
     class InfluenceGraph {
-        std::vector<std::vector<int>> influence_graph;
+        using Word = uint64_t;
+        static constexpr int BITS_PER_WORD = 64;
 
-        int influence(int v1, int v2) const {
-            return influence_graph[v1] [v2];
+        int num_variables;
+        int words_per_row;
+        std::vector<Word> influence_bits;
+        std::vector<std::vector<int>> neighbors;
+
+        bool influence(int v1, int v2) const {
+            return (influence_bits[static_cast<size_t>(v1) * words_per_row + v2 / BITS_PER_WORD] >>
+                    (v2 % BITS_PER_WORD)) & 1;
         }
     public:
-        InfluenceGraph(int n);
+        explicit InfluenceGraph(int n);
+
+        void set_influence(int v1, int v2);
 
-        void set_influence(int v1, int v2, int val = 1) {
-            influence_graph[v1][v2] = val;
-            influence_graph[v2][v1] = val;
+        int get_num_variables() const {
+            return num_variables;
         }
 
         double compute_function(const std::vector <int> &order) const;
 
-        double compute_function_incremental_swap(const std::vector <int> &order,
+        // positions[v] is the index of variable v in order
+        double compute_function_incremental_swap(const std::vector <int> &order, const std::vector<int> &positions,
                                                  double totalDistance, int swapIndex1, int swapIndex2) const;
     };
 
@@ -40,18 +55,30 @@ namespace variable_ordering {
         std::shared_ptr<utils::RandomNumberGenerator> rng;
         const int runs;
         const int iterations_per_run;
+        const int num_threads;
 
-        double optimize_variable_ordering_gamer(const InfluenceGraph & ig, int iterations, std::vector <int> &order) const;
+        // Only swaps variables within the same partition: positions [partition_begin[p], partition_begin[p] +
+        // partition_sizes[p]) of the order
+        static double optimize_variable_ordering_gamer(const InfluenceGraph &ig, int iterations, std::vector<int> &order,
+                                                       const std::vector<int> &partition_begin,
+                                                       const std::vector<int> &partition_sizes,
+                                                       utils::RandomNumberGenerator &run_rng);
 
-        /*TODO: void optimize_variable_ordering_gamer(const InfluenceGraph & ig, std::vector <int> &order,
-                                              std::vector <int> &partition_begin,
-                                              std::vector <int> &partition_sizes,
-                                              int iterations = 50000) const;*/
+        // Optimizes the initial order and runs random shuffles of it (within the partitions) concurrently, each
+        // with its own random number generator, and returns the best order
+        std::vector<int> optimize_multi_start(const InfluenceGraph &ig, const std::vector<int> &initial_order,
+                                              const std::vector<int> &partition_begin,
+                                              const std::vector<int> &partition_sizes) const;
 
     public:
-        explicit GamerVariableOrdering(int runs, int iterations_per_run, int random_seed);
+        explicit GamerVariableOrdering(int runs, int iterations_per_run, int num_threads, int random_seed);
         virtual ~GamerVariableOrdering() = default;
         std::vector<int> compute_variable_ordering(const AbstractTask & task) const override;
+
+        // The variables of each partition are placed contiguously, in the order of the partitions, and only
+        // reordered within their partition
+        std::vector<int> compute_variable_ordering(const AbstractTask &task,
+                                                   const std::vector<std::vector<int>> &partitions) const override;
         virtual void print_options() const override;
 
     };
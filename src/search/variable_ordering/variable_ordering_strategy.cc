@@ -1,7 +1,32 @@
 #include "variable_ordering_strategy.h"
 
+#include "../abstract_task.h"
 #include "../plugins/plugin.h"
 
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace variable_ordering {
+    vector<int> VariableOrderingStrategy::compute_variable_ordering(const AbstractTask &task,
+                                                                    const vector<vector<int>> &partitions) const {
+        vector<int> position(task.get_num_variables());
+        vector<int> order = compute_variable_ordering(task);
+        for (size_t i = 0; i < order.size(); ++i) {
+            position[order[i]] = i;
+        }
+
+        order.clear();
+        for (const auto &partition : partitions) {
+            size_t begin = order.size();
+            order.insert(order.end(), partition.begin(), partition.end());
+            sort(order.begin() + begin, order.end(), [&](int v1, int v2) { return position[v1] < position[v2]; });
+        }
+        assert(static_cast<int>(order.size()) == task.get_num_variables());
+        return order;
+    }
+}
 
 static class VariableOrderingCategoryPlugin : public plugins::TypedCategoryPlugin<variable_ordering::VariableOrderingStrategy> {
 public:
@@ -10,6 +10,13 @@ namespace variable_ordering {
     public:
         virtual ~VariableOrderingStrategy(){}
         virtual std::vector<int> compute_variable_ordering(const AbstractTask & task) const = 0;
+        /*
+         * Orders the variables so that the variables of each partition are contiguous, in the order of the
+         * partitions. The partitions must contain every variable exactly once. The default implementation keeps the
+         * relative order of compute_variable_ordering(task) within each partition.
+         */
+        virtual std::vector<int> compute_variable_ordering(const AbstractTask & task,
+                                                           const std::vector<std::vector<int>> & partitions) const;
         virtual void print_options() const = 0;
 
     };